@@ -1,16 +1,218 @@
+#define _POSIX_C_SOURCE 200809L // mmap, open, fstat
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <ctype.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+// Verification threads (build with -pthread) and the minimum row slice each one gets
+#define VERIFY_THREADS 4
+#define MIN_WORDS_PER_THREAD 1024
+// Default number of oracle queries submitted together during verification
+#define ORACLE_BATCH_SIZE 256
+// Threads counting degrees over a binary edge list, and the text reader's chunk size
+#define COUNT_THREADS 4
+#define EDGE_READ_CHUNK (1 << 20)
+
+// --- Bit-Packed Relationship Matrix ---
+/*
+ * Row-major, 1 bit per pair, packed into 64-bit words.
+ * Bit j of row i is set when person 'i' knows person 'j'.
+ * Uses 32x less memory than an int matrix and lives on the heap.
+ *
+ * With the dual layout, colBits holds the transpose as well, so
+ * column j ("who knows j") can be read as a contiguous row of words.
+ */
+typedef struct {
+    int n;
+    size_t wordsPerRow;
+    uint64_t *bits;
+    uint64_t *colBits; // Column-major copy, NULL when not kept
+} BitMatrix;
+
+BitMatrix* createBitMatrix(int n, int keepColumns) {
+    BitMatrix* M = (BitMatrix*)malloc(sizeof(BitMatrix));
+    if (M == NULL) {
+        return NULL;
+    }
+    M->n = n;
+    M->wordsPerRow = ((size_t)n + 63) / 64;
+    // calloc so every relation starts as 0 ("does not know")
+    M->bits = (uint64_t*)calloc((size_t)n * M->wordsPerRow, sizeof(uint64_t));
+    if (M->bits == NULL) {
+        free(M);
+        return NULL;
+    }
+    M->colBits = NULL;
+    if (keepColumns) {
+        M->colBits = (uint64_t*)calloc((size_t)n * M->wordsPerRow, sizeof(uint64_t));
+        if (M->colBits == NULL) {
+            free(M->bits);
+            free(M);
+            return NULL;
+        }
+    }
+    return M;
+}
+
+void freeBitMatrix(BitMatrix* M) {
+    if (M == NULL) return;
+    free(M->bits);
+    free(M->colBits);
+    free(M);
+}
+
+// Pointer to the first word of row i
+static inline uint64_t* bitRow(const BitMatrix* M, int i) {
+    return M->bits + (size_t)i * M->wordsPerRow;
+}
+
+// Pointer to the first word of column j (only valid with the dual layout)
+static inline uint64_t* bitColumn(const BitMatrix* M, int j) {
+    return M->colBits + (size_t)j * M->wordsPerRow;
+}
+
+static inline void writeBit(uint64_t* word, int bit, int value) {
+    uint64_t mask = (uint64_t)1 << (bit & 63);
+    if (value) {
+        *word |= mask;
+    } else {
+        *word &= ~mask;
+    }
+}
+
+void setKnows(BitMatrix* M, int i, int j, int value) {
+    writeBit(bitRow(M, i) + (j >> 6), j, value);
+    if (M->colBits != NULL) {
+        writeBit(bitColumn(M, j) + (i >> 6), i, value);
+    }
+}
 
 /* 
- * M[i][j] = 1 means person 'i' knows person 'j'.
+ * knows(i, j) = 1 means person 'i' knows person 'j'.
  */
-int knows(int i, int j, int n, int M[n][n]) {
-    return M[i][j];
+static inline int knows(int i, int j, const BitMatrix* M) {
+    return (int)((bitRow(M, i)[j >> 6] >> (j & 63)) & 1);
+}
+
+// --- Parallel Verification ---
+/*
+ * Each task checks one slice [beginWord, endWord) of the candidate's row
+ * and column. The shared 'violation' flag lets every thread stop early
+ * once any of them finds a broken condition.
+ */
+typedef struct {
+    const BitMatrix* M;
+    int candidate;
+    size_t beginWord;
+    size_t endWord;
+    atomic_int* violation;
+} VerifyTask;
+
+// Word w of column 'candidate' must have every valid bit set except the candidate's own
+static inline uint64_t expectedColumnWord(const BitMatrix* M, size_t w, int candidate) {
+    uint64_t expected = ~(uint64_t)0;
+    size_t firstBit = w * 64;
+    if (firstBit + 64 > (size_t)M->n) {
+        expected >>= (firstBit + 64 - (size_t)M->n); // Ignore padding bits past n
+    }
+    if ((size_t)candidate >> 6 == w) {
+        expected &= ~((uint64_t)1 << (candidate & 63));
+    }
+    return expected;
+}
+
+static int verifySlice(const VerifyTask* task) {
+    const BitMatrix* M = task->M;
+    const uint64_t* row = bitRow(M, task->candidate);
+
+    for (size_t w = task->beginWord; w < task->endWord; w++) {
+        // Poll the shared flag once per 64 words (4096 relations)
+        if ((w & 63) == 0 && atomic_load_explicit(task->violation, memory_order_relaxed)) {
+            return 0;
+        }
+
+        // Condition 1: Candidate must know NO ONE (M[c][c] is always 0)
+        if (row[w] != 0) {
+            return 0;
+        }
+
+        // Condition 2: Candidate must be known by EVERYONE
+        if (M->colBits != NULL) {
+            // Dual layout: the column is a sequential row of the transpose
+            if (bitColumn(M, task->candidate)[w] != expectedColumnWord(M, w, task->candidate)) {
+                return 0;
+            }
+        } else {
+            // Row-major only: fall back to one strided probe per person
+            int end = (w + 1) * 64 < (size_t)M->n ? (int)((w + 1) * 64) : M->n;
+            for (int k = (int)(w * 64); k < end; k++) {
+                if (k != task->candidate && !knows(k, task->candidate, M)) {
+                    return 0;
+                }
+            }
+        }
+    }
+    return 1;
+}
+
+static void* verifyWorker(void* arg) {
+    VerifyTask* task = (VerifyTask*)arg;
+    if (!verifySlice(task)) {
+        atomic_store(task->violation, 1);
+    }
+    return NULL;
+}
+
+// Returns 1 if 'candidate' knows no one and is known by everyone
+int verify_candidate(const BitMatrix* M, int candidate) {
+    atomic_int violation = 0;
+    size_t words = M->wordsPerRow;
+
+    int threads = VERIFY_THREADS;
+    if (words / MIN_WORDS_PER_THREAD < (size_t)threads) {
+        threads = (int)(words / MIN_WORDS_PER_THREAD);
+    }
+
+    // Small matrices are not worth spawning threads for
+    if (threads <= 1) {
+        VerifyTask task = { M, candidate, 0, words, &violation };
+        return verifySlice(&task);
+    }
+
+    pthread_t tids[VERIFY_THREADS];
+    VerifyTask tasks[VERIFY_THREADS];
+    size_t chunk = (words + threads - 1) / threads;
+    int started = 0;
+
+    for (int t = 0; t < threads; t++) {
+        size_t begin = (size_t)t * chunk;
+        size_t end = begin + chunk < words ? begin + chunk : words;
+        tasks[t] = (VerifyTask){ M, candidate, begin, end, &violation };
+        if (pthread_create(&tids[t], NULL, verifyWorker, &tasks[t]) == 0) {
+            started++;
+        } else {
+            verifyWorker(&tasks[t]); // Could not spawn: check this slice here
+        }
+    }
+    for (int t = 0; t < started; t++) {
+        pthread_join(tids[t], NULL);
+    }
+
+    return !atomic_load(&violation);
 }
 
 // --- The O(n) Optimal Solution ---
 
-int find_celebrity(int n, int M[n][n]) {
+int find_celebrity(const BitMatrix* M) {
+    int n = M->n;
+
     // 1. Finding a Candidate (First O(n) Pass)
     // Initialize two pointers, i (start) and j (end), to eliminate non-celebrities quickly.
     int i = 0; 
@@ -19,7 +221,7 @@ int find_celebrity(int n, int M[n][n]) {
     while (i < j) {
         
         // If 'i' knows 'j', then 'i' cannot be the celebrity (Celebrity knows NO ONE).
-        if (knows(i, j, n, M)) {
+        if (knows(i, j, M)) {
             i++; 
         } 
         // If 'i' does NOT know 'j', then 'j' cannot be the celebrity (Everyone must know the Celebrity).
@@ -32,40 +234,718 @@ int find_celebrity(int n, int M[n][n]) {
     int candidate = i;
 
     // 2. Verification (Second O(n) Pass)
-    
-    for (int k = 0; k < n; k++) {
+    // Both conditions stream the candidate's row and column 64 relations per word.
+    if (!verify_candidate(M, candidate)) {
+        return -1; // Fail: Candidate knows someone, or someone does not know the candidate.
+    }
+
+    // If both verification checks pass, the candidate is the celebrity.
+    return candidate;
+}
+
+// --- Oracle-Driven Solution ---
+/*
+ * When knows(i, j) is an expensive call to another store, the caller
+ * supplies it as a callback. 'knowsBatch' is optional: it answers
+ * 'count' independent queries at once, so the oracle can keep many
+ * lookups in flight. 'calls' and 'batches' report how much was asked.
+ */
+typedef int (*KnowsFn)(void* ctx, int i, int j);
+typedef void (*KnowsBatchFn)(void* ctx, const int* from, const int* to, int* answers, int count);
+
+typedef struct {
+    KnowsFn knows;
+    KnowsBatchFn knowsBatch; // NULL to issue single queries only
+    void* ctx;
+    int batchSize;           // Queries per batch (min 2), <= 0 means ORACLE_BATCH_SIZE
+    long calls;              // Individual relations asked
+    long batches;            // Batched submissions made
+} KnowsOracle;
+
+static int askOracle(KnowsOracle* oracle, int i, int j) {
+    oracle->calls++;
+    return oracle->knows(oracle->ctx, i, j);
+}
+
+static void askOracleBatch(KnowsOracle* oracle, const int* from, const int* to, int* answers, int count) {
+    oracle->calls += count;
+    if (oracle->knowsBatch != NULL) {
+        oracle->batches++;
+        oracle->knowsBatch(oracle->ctx, from, to, answers, count);
+    } else {
+        for (int q = 0; q < count; q++) {
+            answers[q] = oracle->knows(oracle->ctx, from[q], to[q]);
+        }
+    }
+}
+
+/*
+ * Same two passes as find_celebrity, but every relation comes from the oracle.
+ * During elimination, survivor[k] records who was standing when k was ruled out:
+ *   k < candidate was the 'i' pointer, so knows(k, survivor[k]) = 1 is known;
+ *   k > candidate was the 'j' pointer, so knows(survivor[k], k) = 0 is known.
+ * Where survivor[k] is the final candidate, verification reuses that answer.
+ * Returns the celebrity, -1 if none, or -2 if memory allocation failed.
+ */
+int find_celebrity_oracle(int n, KnowsOracle* oracle) {
+    int* survivor = (int*)malloc((size_t)n * sizeof(int));
+    if (survivor == NULL) {
+        return -2;
+    }
+
+    // 1. Finding a Candidate (First O(n) Pass) - inherently one query at a time
+    int i = 0;
+    int j = n - 1;
+    while (i < j) {
+        if (askOracle(oracle, i, j)) {
+            survivor[i] = j;
+            i++;
+        } else {
+            survivor[j] = i;
+            j--;
+        }
+    }
+    int candidate = i;
+    survivor[candidate] = candidate;
+
+    // 2. Verification (Second O(n) Pass) - independent queries, submitted in batches
+    int batchSize = oracle->batchSize > 0 ? oracle->batchSize : ORACLE_BATCH_SIZE;
+    if (batchSize < 2) {
+        batchSize = 2; // Each person adds up to two queries
+    }
+    int* from = (int*)malloc((size_t)batchSize * sizeof(int));
+    int* to = (int*)malloc((size_t)batchSize * sizeof(int));
+    int* answers = (int*)malloc((size_t)batchSize * sizeof(int));
+    if (from == NULL || to == NULL || answers == NULL) {
+        free(from);
+        free(to);
+        free(answers);
+        free(survivor);
+        return -2;
+    }
+
+    int result = candidate;
+    int pending = 0;
+    for (int k = 0; k < n && result != -1; k++) {
         if (k != candidate) {
-            
-            // Condition 1: Candidate must know NO ONE 
-            if (knows(candidate, k, n, M)) {
-                return -1; // Fail: Candidate knows someone.
+            int memoized = (survivor[k] == candidate);
+
+            // Condition 1: Candidate must know NO ONE (cached for k > candidate)
+            if (!(memoized && k > candidate)) {
+                from[pending] = candidate;
+                to[pending] = k;
+                pending++;
             }
+            // Condition 2: Candidate must be known by EVERYONE (cached for k < candidate)
+            if (!(memoized && k < candidate)) {
+                from[pending] = k;
+                to[pending] = candidate;
+                pending++;
+            }
+        }
 
-            // Condition 2: Candidate must be known by EVERYONE
-            if (!knows(k, candidate, n, M)) {
-                return -1; // Fail: Candidate is not known by person 'k'.
+        // Flush when the batch is (nearly) full or the scan is finished
+        if (pending > batchSize - 2 || (k == n - 1 && pending > 0)) {
+            askOracleBatch(oracle, from, to, answers, pending);
+            for (int q = 0; q < pending; q++) {
+                int expected = (to[q] == candidate); // Others know c, c knows no one
+                if (answers[q] != expected) {
+                    result = -1; // Early exit: no further batches are sent
+                    break;
+                }
             }
+            pending = 0;
         }
     }
 
-    // If both verification checks pass, the candidate is the celebrity.
-    return candidate;
+    free(from);
+    free(to);
+    free(answers);
+    free(survivor);
+    return result;
+}
+
+// Oracle adapters backed by the in-memory matrix
+static int matrixKnows(void* ctx, int i, int j) {
+    return knows(i, j, (const BitMatrix*)ctx);
+}
+
+static void matrixKnowsBatch(void* ctx, const int* from, const int* to, int* answers, int count) {
+    for (int q = 0; q < count; q++) {
+        answers[q] = knows(from[q], to[q], (const BitMatrix*)ctx);
+    }
+}
+
+// --- Incremental Celebrity Maintenance ---
+/*
+ * Keeps in-degree and out-degree per person as "i knows j" edges are
+ * added or removed. A celebrity has outDegree 0 and inDegree n-1, and at
+ * most one person can qualify (two such people would have to know each
+ * other). An update only changes the status of its two endpoints, so the
+ * current celebrity is re-checked in O(1) and answered in O(1).
+ */
+typedef struct {
+    BitMatrix* M;   // Caller's matrix, updated in place and not owned by the tracker
+    int* inDegree;
+    int* outDegree;
+    int celebrity;  // -1 when nobody qualifies
+} CelebrityTracker;
+
+static inline int isCelebrity(const CelebrityTracker* T, int p) {
+    return T->outDegree[p] == 0 && T->inDegree[p] == T->M->n - 1;
+}
+
+/*
+ * Tracks the edges already stored in M. The degrees are seeded from its
+ * set bits, and later updates are written back into M, which is also
+ * how duplicate updates are recognised. No second n x n copy is kept.
+ */
+CelebrityTracker* createTracker(BitMatrix* M) {
+    CelebrityTracker* T = (CelebrityTracker*)malloc(sizeof(CelebrityTracker));
+    if (T == NULL) {
+        return NULL;
+    }
+    T->M = M;
+    T->inDegree = (int*)calloc((size_t)M->n, sizeof(int));
+    T->outDegree = (int*)calloc((size_t)M->n, sizeof(int));
+    if (T->inDegree == NULL || T->outDegree == NULL) {
+        free(T->inDegree);
+        free(T->outDegree);
+        free(T);
+        return NULL;
+    }
+
+    for (int i = 0; i < M->n; i++) {
+        const uint64_t* row = bitRow(M, i);
+        for (size_t w = 0; w < M->wordsPerRow; w++) {
+            uint64_t word = row[w];
+            while (word != 0) {
+                int j = (int)(w * 64) + __builtin_ctzll(word);
+                if (j != i) {
+                    T->outDegree[i]++;
+                    T->inDegree[j]++;
+                }
+                word &= word - 1; // Clear the lowest set bit
+            }
+        }
+    }
+    T->celebrity = -1;
+    for (int p = 0; p < M->n && T->celebrity == -1; p++) {
+        if (isCelebrity(T, p)) {
+            T->celebrity = p;
+        }
+    }
+    return T;
+}
+
+void freeTracker(CelebrityTracker* T) {
+    if (T == NULL) return;
+    free(T->inDegree);
+    free(T->outDegree);
+    free(T);
+}
+
+// Re-evaluate the two people touched by an update
+static void refreshCelebrity(CelebrityTracker* T, int i, int j) {
+    if (T->celebrity == i || T->celebrity == j) {
+        T->celebrity = -1;
+    }
+    if (isCelebrity(T, i)) {
+        T->celebrity = i;
+    } else if (isCelebrity(T, j)) {
+        T->celebrity = j;
+    }
+}
+
+// Records "i knows j". Returns 1 if the edge was new, 0 if it was already there.
+int trackerAddEdge(CelebrityTracker* T, int i, int j) {
+    if (i == j || knows(i, j, T->M)) {
+        return 0;
+    }
+    setKnows(T->M, i, j, 1);
+    T->outDegree[i]++;
+    T->inDegree[j]++;
+    refreshCelebrity(T, i, j);
+    return 1;
+}
+
+// Forgets "i knows j". Returns 1 if the edge existed, 0 otherwise.
+int trackerRemoveEdge(CelebrityTracker* T, int i, int j) {
+    if (i == j || !knows(i, j, T->M)) {
+        return 0;
+    }
+    setKnows(T->M, i, j, 0);
+    T->outDegree[i]--;
+    T->inDegree[j]--;
+    refreshCelebrity(T, i, j);
+    return 1;
+}
+
+// O(1): the current celebrity, or -1
+static inline int trackerCelebrity(const CelebrityTracker* T) {
+    return T->celebrity;
+}
+
+// --- Sparse Edge-List Input ---
+/*
+ * Real graphs are sparse, so a celebrity candidate can be picked from
+ * degree counts in one pass over the edges, using O(n) memory. Edges
+ * may repeat, so a second pass confirms the candidate against the
+ * distinct people who know them. Self-loops are ignored.
+ *
+ * Text format:   "n" on the first line, then one "i j" pair per line.
+ * Binary format: uint32 n, then uint32 (i, j) pairs in native byte order.
+ *                The file is mmap-ed and the pairs are counted in parallel.
+ */
+typedef struct {
+    int n;
+    long* inDegree;
+    long* outDegree;
+} DegreeCounts;
+
+static DegreeCounts* createDegreeCounts(int n) {
+    DegreeCounts* D = (DegreeCounts*)malloc(sizeof(DegreeCounts));
+    if (D == NULL) {
+        return NULL;
+    }
+    D->n = n;
+    D->inDegree = (long*)calloc((size_t)n, sizeof(long));
+    D->outDegree = (long*)calloc((size_t)n, sizeof(long));
+    if (D->inDegree == NULL || D->outDegree == NULL) {
+        free(D->inDegree);
+        free(D->outDegree);
+        free(D);
+        return NULL;
+    }
+    return D;
+}
+
+void freeDegreeCounts(DegreeCounts* D) {
+    if (D == NULL) return;
+    free(D->inDegree);
+    free(D->outDegree);
+    free(D);
+}
+
+// Returns 0 if the edge is out of range
+static inline int countEdge(DegreeCounts* D, uint32_t i, uint32_t j) {
+    if (i >= (uint32_t)D->n || j >= (uint32_t)D->n) {
+        return 0;
+    }
+    if (i != j) {
+        D->outDegree[i]++;
+        D->inDegree[j]++;
+    }
+    return 1;
+}
+
+/*
+ * Picks the only person who can still be the celebrity: outDegree 0 and
+ * at least n-1 incoming edges. Repeated edges can inflate inDegree, so
+ * the pick must be confirmed by a second pass. If a celebrity exists,
+ * everyone else knows them and has outDegree > 0, so the first match is
+ * the one to confirm.
+ */
+int candidate_from_degrees(const DegreeCounts* D) {
+    for (int p = 0; p < D->n; p++) {
+        if (D->outDegree[p] == 0 && D->inDegree[p] >= D->n - 1) {
+            return p;
+        }
+    }
+    return -1;
+}
+
+// Sets bit i of the candidate's "known by" bitmap. Returns 0 if the edge is out of range.
+static inline int markKnower(uint64_t* knownBy, int n, int candidate, uint32_t i, uint32_t j) {
+    if (i >= (uint32_t)n || j >= (uint32_t)n) {
+        return 0;
+    }
+    if (j == (uint32_t)candidate && i != j) {
+        knownBy[i >> 6] |= (uint64_t)1 << (i & 63);
+    }
+    return 1;
+}
+
+// The candidate is the celebrity when n-1 distinct people know them
+static int knownByEveryone(const uint64_t* knownBy, int n) {
+    long known = 0;
+    for (size_t w = 0; w < ((size_t)n + 63) / 64; w++) {
+        known += __builtin_popcountll(knownBy[w]);
+    }
+    return known == n - 1;
+}
+
+// Chunked reader for the text format
+typedef struct {
+    FILE* fp;
+    char* buf;
+    size_t pos;
+    size_t len;
+} TextEdgeReader;
+
+/*
+ * Reads the next unsigned integer. Returns 1 with a value, 0 at end of
+ * input, and -1 on any character that is neither a digit nor whitespace.
+ */
+static int readUnsigned(TextEdgeReader* r, uint64_t* value) {
+    int c;
+    int digits = 0;
+    *value = 0;
+    for (;;) {
+        if (r->pos == r->len) {
+            r->len = fread(r->buf, 1, EDGE_READ_CHUNK, r->fp);
+            r->pos = 0;
+            if (r->len == 0) {
+                return digits > 0;
+            }
+        }
+        c = (unsigned char)r->buf[r->pos++];
+        if (c >= '0' && c <= '9') {
+            // Stop growing past UINT32_MAX, such values are rejected anyway
+            if (*value <= UINT32_MAX) {
+                *value = *value * 10 + (uint64_t)(c - '0');
+            }
+            digits++;
+        } else if (!isspace(c)) {
+            return -1;
+        } else if (digits > 0) {
+            return 1;
+        }
+    }
+}
+
+// Opens a text edge list and reads n. Returns 0 on error.
+static int openTextEdges(TextEdgeReader* r, const char* path, int* n) {
+    uint64_t value;
+    r->fp = fopen(path, "rb");
+    if (r->fp == NULL) {
+        return 0;
+    }
+    r->buf = (char*)malloc(EDGE_READ_CHUNK);
+    r->pos = 0;
+    r->len = 0;
+    if (r->buf == NULL || readUnsigned(r, &value) != 1 || value < 2 || value > INT32_MAX) {
+        free(r->buf);
+        fclose(r->fp);
+        return 0;
+    }
+    *n = (int)value;
+    return 1;
+}
+
+static void closeTextEdges(TextEdgeReader* r) {
+    free(r->buf);
+    fclose(r->fp);
+}
+
+// Returns 1 with the next edge, 0 at the end of the list, -1 on malformed input
+static int nextTextEdge(TextEdgeReader* r, uint32_t* i, uint32_t* j) {
+    uint64_t a, b;
+    int status = readUnsigned(r, &a);
+    if (status != 1) {
+        return status;
+    }
+    if (readUnsigned(r, &b) != 1 || a > UINT32_MAX || b > UINT32_MAX) {
+        return -1; // Dangling or out-of-range edge
+    }
+    *i = (uint32_t)a;
+    *j = (uint32_t)b;
+    return 1;
+}
+
+// Text edge list, first pass: streamed in EDGE_READ_CHUNK-sized reads. Returns NULL on error.
+DegreeCounts* count_degrees_text(const char* path) {
+    TextEdgeReader r;
+    int n;
+    if (!openTextEdges(&r, path, &n)) {
+        return NULL;
+    }
+
+    DegreeCounts* D = createDegreeCounts(n);
+    int status = (D != NULL) ? 1 : -1;
+    uint32_t i, j;
+    while (status == 1) {
+        status = nextTextEdge(&r, &i, &j);
+        if (status == 1 && !countEdge(D, i, j)) {
+            status = -1;
+        }
+    }
+    if (status < 0) {
+        freeDegreeCounts(D);
+        D = NULL;
+    }
+
+    closeTextEdges(&r);
+    return D;
+}
+
+// Text edge list, second pass. Returns 1 if the candidate is the celebrity, 0 if not, -1 on error.
+int confirm_celebrity_text(const char* path, int candidate) {
+    TextEdgeReader r;
+    int n;
+    if (!openTextEdges(&r, path, &n)) {
+        return -1;
+    }
+
+    uint64_t* knownBy = (uint64_t*)calloc(((size_t)n + 63) / 64, sizeof(uint64_t));
+    int status = (knownBy != NULL) ? 1 : -1;
+    uint32_t i, j;
+    while (status == 1) {
+        status = nextTextEdge(&r, &i, &j);
+        if (status == 1 && !markKnower(knownBy, n, candidate, i, j)) {
+            status = -1;
+        }
+    }
+    int result = (status < 0) ? -1 : knownByEveryone(knownBy, n);
+
+    free(knownBy);
+    closeTextEdges(&r);
+    return result;
+}
+
+/*
+ * One slice of the binary pairs. The first pass counts into 'local',
+ * the second marks the candidate's in-neighbours in 'knownBy'. Both are
+ * private to the task and merged after the join.
+ */
+typedef struct {
+    const uint32_t* pairs;
+    size_t beginEdge;
+    size_t endEdge;
+    DegreeCounts* local;
+    uint64_t* knownBy;
+    int n;
+    int candidate;
+    int ok;
+} CountTask;
+
+static void* countWorker(void* arg) {
+    CountTask* task = (CountTask*)arg;
+    task->ok = 1;
+    for (size_t e = task->beginEdge; e < task->endEdge; e++) {
+        uint32_t i = task->pairs[2 * e];
+        uint32_t j = task->pairs[2 * e + 1];
+        int ok = (task->local != NULL) ? countEdge(task->local, i, j)
+                                       : markKnower(task->knownBy, task->n, task->candidate, i, j);
+        if (!ok) {
+            task->ok = 0;
+            break;
+        }
+    }
+    return NULL;
+}
+
+// Maps a binary edge list. Returns NULL on error; words[0] is n and the pairs follow.
+static const uint32_t* mapBinaryEdges(const char* path, size_t* mapSize, size_t* edges) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return NULL;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(uint32_t) ||
+        (st.st_size - sizeof(uint32_t)) % (2 * sizeof(uint32_t)) != 0) {
+        close(fd);
+        return NULL;
+    }
+    void* map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        return NULL;
+    }
+    const uint32_t* words = (const uint32_t*)map;
+    if (words[0] < 2 || words[0] > INT32_MAX) {
+        munmap(map, (size_t)st.st_size);
+        return NULL;
+    }
+    *mapSize = (size_t)st.st_size;
+    *edges = (*mapSize - sizeof(uint32_t)) / (2 * sizeof(uint32_t));
+    return words;
+}
+
+// Starts the tasks that have their buffers, runs the rest inline if a thread fails, and joins
+static void runCountTasks(CountTask tasks[COUNT_THREADS]) {
+    pthread_t tids[COUNT_THREADS];
+    int started[COUNT_THREADS] = {0};
+    for (int t = 0; t < COUNT_THREADS; t++) {
+        if (tasks[t].local == NULL && tasks[t].knownBy == NULL) {
+            continue;
+        }
+        started[t] = (pthread_create(&tids[t], NULL, countWorker, &tasks[t]) == 0);
+        if (!started[t]) {
+            countWorker(&tasks[t]);
+        }
+    }
+    for (int t = 0; t < COUNT_THREADS; t++) {
+        if (started[t]) {
+            pthread_join(tids[t], NULL);
+        }
+    }
+}
+
+// Splits the pairs into one contiguous slice per thread
+static void sliceCountTasks(CountTask tasks[COUNT_THREADS], const uint32_t* words, size_t edges) {
+    size_t chunk = (edges + COUNT_THREADS - 1) / COUNT_THREADS;
+    for (int t = 0; t < COUNT_THREADS; t++) {
+        size_t begin = (size_t)t * chunk < edges ? (size_t)t * chunk : edges;
+        size_t end = begin + chunk < edges ? begin + chunk : edges;
+        tasks[t] = (CountTask){ words + 1, begin, end, NULL, NULL, (int)words[0], -1, 0 };
+    }
+}
+
+// Binary edge list, first pass: mmap-ed and split across COUNT_THREADS. Returns NULL on error.
+DegreeCounts* count_degrees_binary(const char* path) {
+    size_t mapSize, edges;
+    const uint32_t* words = mapBinaryEdges(path, &mapSize, &edges);
+    if (words == NULL) {
+        return NULL;
+    }
+    int n = (int)words[0];
+    DegreeCounts* D = createDegreeCounts(n);
+    if (D == NULL) {
+        munmap((void*)words, mapSize);
+        return NULL;
+    }
+
+    // Each thread counts into its own O(n) counters; thread 0 counts straight into the result
+    CountTask tasks[COUNT_THREADS];
+    sliceCountTasks(tasks, words, edges);
+    int ok = 1;
+    for (int t = 0; t < COUNT_THREADS; t++) {
+        tasks[t].local = (t == 0) ? D : createDegreeCounts(n);
+        ok = ok && tasks[t].local != NULL;
+    }
+    runCountTasks(tasks);
+
+    for (int t = 0; t < COUNT_THREADS; t++) {
+        if (tasks[t].local == NULL) {
+            continue;
+        }
+        ok = ok && tasks[t].ok;
+        if (t > 0) {
+            for (int p = 0; p < n; p++) {
+                D->inDegree[p] += tasks[t].local->inDegree[p];
+                D->outDegree[p] += tasks[t].local->outDegree[p];
+            }
+            freeDegreeCounts(tasks[t].local);
+        }
+    }
+
+    munmap((void*)words, mapSize);
+    if (!ok) {
+        freeDegreeCounts(D);
+        return NULL;
+    }
+    return D;
+}
+
+// Binary edge list, second pass. Returns 1 if the candidate is the celebrity, 0 if not, -1 on error.
+int confirm_celebrity_binary(const char* path, int candidate) {
+    size_t mapSize, edges;
+    const uint32_t* words = mapBinaryEdges(path, &mapSize, &edges);
+    if (words == NULL) {
+        return -1;
+    }
+    int n = (int)words[0];
+    size_t wordsPerMap = ((size_t)n + 63) / 64;
+
+    // Each thread marks its own n-bit map, then the maps are OR-ed into the first one
+    CountTask tasks[COUNT_THREADS];
+    sliceCountTasks(tasks, words, edges);
+    int ok = 1;
+    for (int t = 0; t < COUNT_THREADS; t++) {
+        tasks[t].candidate = candidate;
+        tasks[t].knownBy = (uint64_t*)calloc(wordsPerMap, sizeof(uint64_t));
+        ok = ok && tasks[t].knownBy != NULL;
+    }
+    if (ok) {
+        runCountTasks(tasks);
+        for (int t = 0; t < COUNT_THREADS; t++) {
+            ok = ok && tasks[t].ok;
+            for (size_t w = 0; t > 0 && w < wordsPerMap; w++) {
+                tasks[0].knownBy[w] |= tasks[t].knownBy[w];
+            }
+        }
+    }
+    int result = ok ? knownByEveryone(tasks[0].knownBy, n) : -1;
+
+    for (int t = 0; t < COUNT_THREADS; t++) {
+        free(tasks[t].knownBy);
+    }
+    munmap((void*)words, mapSize);
+    return result;
+}
+
+static int runEdgeListMode(void) {
+    char path[1024];
+    int format;
+
+    printf("Enter the edge list file path: ");
+    if (scanf("%1023s", path) != 1) {
+        printf("Error reading the file path.\n");
+        return 1;
+    }
+    printf("Enter the format (1 = text, 2 = binary): ");
+    if (scanf("%d", &format) != 1 || (format != 1 && format != 2)) {
+        printf("Error: Format must be 1 or 2.\n");
+        return 1;
+    }
+
+    DegreeCounts* D = (format == 1) ? count_degrees_text(path) : count_degrees_binary(path);
+    if (D == NULL) {
+        printf("Error: Could not read a valid edge list from '%s'.\n", path);
+        return 1;
+    }
+
+    // Confirm the degree-count pick against duplicate edges with a second pass
+    int celebrity_index = candidate_from_degrees(D);
+    if (celebrity_index != -1) {
+        int confirmed = (format == 1) ? confirm_celebrity_text(path, celebrity_index)
+                                      : confirm_celebrity_binary(path, celebrity_index);
+        if (confirmed < 0) {
+            printf("Error: Could not re-read the edge list from '%s'.\n", path);
+            freeDegreeCounts(D);
+            return 1;
+        }
+        if (!confirmed) {
+            celebrity_index = -1;
+        }
+    }
+
+    printf("\n-----------------------------------------------------\n");
+    printf("FINAL RESULT (Edge List, N = %d)\n", D->n);
+    if (celebrity_index != -1) {
+        printf("The Celebrity is Person P%d (Index %d).\n", celebrity_index, celebrity_index);
+    } else {
+        printf("No celebrity exists in this party.\n");
+    }
+    printf("Time Complexity: O(n + e), Memory: O(n)\n");
+    printf("-----------------------------------------------------\n");
+
+    freeDegreeCounts(D);
+    return 0;
 }
 
 int main() {
     int n;
     
     printf("--- The Celebrity Problem (Optimal O(n) Solution) ---\n");
-    printf("Enter the number of people in the party (N): ");
+    printf("Enter the number of people in the party (N), or 0 to read an edge list file: ");
     
     // Read N from user
-    if (scanf("%d", &n) != 1 || n <= 1) {
+    if (scanf("%d", &n) != 1 || n < 0 || n == 1) {
         printf("Error: N must be an integer greater than 1.\n");
         return 1;
     }
+    if (n == 0) {
+        return runEdgeListMode();
+    }
 
-    // Declare the relationship matrix
-    int M[n][n]; 
+    // Allocate the bit-packed relationship matrix on the heap (dual layout)
+    BitMatrix* M = createBitMatrix(n, 1);
+    if (M == NULL) {
+        printf("Error: Memory allocation failed.\n");
+        return 1;
+    }
 
     printf("\n--- Entering Relationships ---\n");
     printf("Enter 1 if person i knows person j, or 0 otherwise.\n");
@@ -74,21 +954,24 @@ int main() {
     for (int i = 0; i < n; i++) {
         for (int j = 0; j < n; j++) {
             if (i == j) {
-                // A person does not know themselves, set M[i][i] = 0 automatically
-                M[i][j] = 0;
+                // A person does not know themselves, M[i][i] stays 0 automatically
                 printf("M[%d][%d] (i knows i): 0 (Auto-set)\n", i, j);
             } else {
+                int value;
                 printf("M[%d][%d] (P%d knows P%d): ", i, j, i, j);
-                if (scanf("%d", &M[i][j]) != 1 || (M[i][j] != 0 && M[i][j] != 1)) {
+                if (scanf("%d", &value) != 1 || (value != 0 && value != 1)) {
                      printf("Invalid input. Must be 0 or 1. Exiting.\n");
+                     freeBitMatrix(M);
                      return 1;
                 }
+                // Write the answer straight into the packed matrix
+                setKnows(M, i, j, value);
             }
         }
     }
 
     // Find the celebrity
-    int celebrity_index = find_celebrity(n, M);
+    int celebrity_index = find_celebrity(M);
 
     printf("\n-----------------------------------------------------\n");
     printf("FINAL RESULT\n");
@@ -101,5 +984,56 @@ int main() {
     printf("Time Complexity: O(n)\n");
     printf("-----------------------------------------------------\n");
 
+    // Same question asked through the oracle interface, with query accounting
+    KnowsOracle oracle = { matrixKnows, matrixKnowsBatch, M, ORACLE_BATCH_SIZE, 0, 0 };
+    int oracle_index = find_celebrity_oracle(n, &oracle);
+    if (oracle_index == -2) {
+        printf("Error: Memory allocation failed.\n");
+        freeBitMatrix(M);
+        return 1;
+    }
+    printf("Oracle Search Result: %s", oracle_index == -1 ? "No celebrity" : "Person ");
+    if (oracle_index != -1) {
+        printf("P%d", oracle_index);
+    }
+    printf("\nOracle Calls: %ld (in %ld batches, at most %d without memoization)\n",
+           oracle.calls, oracle.batches, 3 * (n - 1));
+    printf("-----------------------------------------------------\n");
+
+    // --- Streaming Edge Updates ---
+    // The tracker updates M in place, so M must outlive it
+    CelebrityTracker* T = createTracker(M);
+    if (T == NULL) {
+        printf("Error: Memory allocation failed.\n");
+        freeBitMatrix(M);
+        return 1;
+    }
+
+    printf("\n--- Streaming Updates ---\n");
+    printf("Enter '+ i j' (P_i now knows P_j), '- i j' (P_i forgets P_j), or 'q' to quit.\n");
+    char op;
+    while (scanf(" %c", &op) == 1 && op != 'q') {
+        int a, b;
+        if ((op != '+' && op != '-') || scanf("%d %d", &a, &b) != 2 ||
+            a < 0 || a >= n || b < 0 || b >= n) {
+            printf("Invalid update. Stopping updates.\n");
+            break;
+        }
+        if (op == '+') {
+            trackerAddEdge(T, a, b);
+        } else {
+            trackerRemoveEdge(T, a, b);
+        }
+
+        int current = trackerCelebrity(T);
+        if (current != -1) {
+            printf("Current Celebrity: P%d\n", current);
+        } else {
+            printf("Current Celebrity: none\n");
+        }
+    }
+
+    freeTracker(T);
+    freeBitMatrix(M);
     return 0;
 }
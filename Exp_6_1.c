@@ -1,75 +1,1139 @@
+#define _POSIX_C_SOURCE 200809L // isatty, sysconf
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <limits.h>
+#include <pthread.h>
+#include <unistd.h>
 
+// Inputs with at least this many activities use the radix sort instead of qsort
+#define RADIX_SORT_THRESHOLD 256
+// Inputs with at least this many activities are sorted and scanned on up to PARALLEL_MAX_THREADS (build with -pthread)
+#define PARALLEL_THRESHOLD (1 << 16)
+#define PARALLEL_MAX_THREADS 64
+// Children per node in the interval partitioning heap (4 siblings share a cache line)
+#define HEAP_ARITY 4
+// Maximum tower height in the machine scheduler's and online selector's skip lists
+#define SKIP_MAX_LEVEL 32
+// stdout buffer used when input is not typed at a terminal
+#define OUTPUT_BUFFER_SIZE (1 << 20)
+
+// --- 0. Output Verbosity ---
+/*
+ * The algorithms below never print; results go into caller buffers and
+ * the report functions decide what to show. Chosen on the command line:
+ *   -q  silent  (errors only)
+ *   -s  summary (headlines and totals)
+ *   -v  full    (every activity, the default)
+ */
+typedef enum {
+    VERBOSITY_SILENT,
+    VERBOSITY_SUMMARY,
+    VERBOSITY_FULL
+} Verbosity;
+
+static Verbosity verbosity = VERBOSITY_FULL;
+
+#define REPORT(level, ...) do { if (verbosity >= (level)) printf(__VA_ARGS__); } while (0)
+
+static void setVerbosity(int argc, char *argv[]) {
+    for (int a = 1; a < argc; a++) {
+        if (strcmp(argv[a], "-q") == 0) verbosity = VERBOSITY_SILENT;
+        else if (strcmp(argv[a], "-s") == 0) verbosity = VERBOSITY_SUMMARY;
+        else if (strcmp(argv[a], "-v") == 0) verbosity = VERBOSITY_FULL;
+    }
+    // Prompts must appear immediately when typing; otherwise write in large blocks
+    if (!isatty(STDIN_FILENO)) {
+        setvbuf(stdout, NULL, _IOFBF, OUTPUT_BUFFER_SIZE);
+    }
+}
+
+// Start/finish times are 32-bit by default; build with -DACTIVITY_TIME_64 for 64-bit timestamps
+#ifdef ACTIVITY_TIME_64
+typedef long long ActivityTime;
+#define TIME_FMT "%lld"
+#define TIME_MIN LLONG_MIN
+#else
+typedef int ActivityTime;
+#define TIME_FMT "%d"
+#define TIME_MIN INT_MIN
+#endif
 
 // --- 1. Define the Activity Structure ---
 
 typedef struct {
-    int start;
-    int finish;
+    ActivityTime start;
+    ActivityTime finish;
     int index; // Original index to identify the selected activity
 } Activity;
 
 // --- 2. Comparison Function for Sorting ---
 
 int compareActivities(const void *a, const void *b) {
-    Activity *activityA = (Activity *)a;
-    Activity *activityB = (Activity *)b;
-    // Sort in non-decreasing order of finish time
-    return activityA->finish - activityB->finish;
+    const Activity *activityA = (const Activity *)a;
+    const Activity *activityB = (const Activity *)b;
+    // Sort in non-decreasing order of finish time.
+    // Compare instead of subtracting, which overflows for large timestamps.
+    return (activityA->finish > activityB->finish) - (activityA->finish < activityB->finish);
 }
 
-// --- 3. The Greedy Algorithm Implementation ---
+// --- 2b. LSD Radix Sort on the Finish (or Start) Time ---
 
-void activity_selector(Activity activities[], int n) {
-    if (n <= 0) {
-        printf("No activities to select.\n");
-        return;
+// Maps a signed time to an unsigned key with the same ordering
+static inline uint64_t timeKey(ActivityTime t) {
+    uint64_t signBit = (uint64_t)1 << (sizeof(ActivityTime) * 8 - 1);
+    return ((uint64_t)t ^ signBit) & (signBit | (signBit - 1));
+}
+
+static inline uint64_t sortKey(const Activity *activity, int byStart) {
+    return timeKey(byStart ? activity->start : activity->finish);
+}
+
+/*
+ * Stable byte-wise LSD radix sort: one counting pass per key byte
+ * (4 for 32-bit times, 8 for 64-bit), moving whole Activity records so
+ * the other time and 'index' travel with their key. Passes where every
+ * key has the same byte are skipped. Returns 0 if the scratch buffer
+ * could not be allocated, leaving the array untouched.
+ */
+static int radixSortActivitiesBy(Activity activities[], int n, int byStart) {
+    Activity *buffer = (Activity *)malloc((size_t)n * sizeof(Activity));
+    if (buffer == NULL) {
+        return 0;
     }
 
-    
+    Activity *src = activities;
+    Activity *dst = buffer;
+
+    for (size_t pass = 0; pass < sizeof(ActivityTime); pass++) {
+        size_t count[256] = {0};
+        int shift = (int)(pass * 8);
+
+        for (int i = 0; i < n; i++) {
+            count[(sortKey(&src[i], byStart) >> shift) & 0xFF]++;
+        }
+        // All keys share this byte: the order would not change
+        if (count[(sortKey(&src[0], byStart) >> shift) & 0xFF] == (size_t)n) {
+            continue;
+        }
+
+        // Prefix sums give each bucket's first output slot
+        size_t offset = 0;
+        for (int b = 0; b < 256; b++) {
+            size_t c = count[b];
+            count[b] = offset;
+            offset += c;
+        }
+        for (int i = 0; i < n; i++) {
+            dst[count[(sortKey(&src[i], byStart) >> shift) & 0xFF]++] = src[i];
+        }
+
+        Activity *tmp = src;
+        src = dst;
+        dst = tmp;
+    }
+
+    if (src != activities) {
+        memcpy(activities, src, (size_t)n * sizeof(Activity));
+    }
+    free(buffer);
+    return 1;
+}
+
+int radixSortActivities(Activity activities[], int n) {
+    return radixSortActivitiesBy(activities, n, 0);
+}
+
+// Radix sort for large inputs, qsort for small ones (or if the radix buffer is unavailable)
+void sortActivitiesByFinish(Activity activities[], int n) {
+    if (n >= RADIX_SORT_THRESHOLD && radixSortActivities(activities, n)) {
+        return;
+    }
     qsort(activities, n, sizeof(Activity), compareActivities);
+}
 
-    printf("\n--- Sorted Activities (by Finish Time) ---\n");
-    for (int i = 0; i < n; i++) {
-        printf("A%d: (Start: %d, Finish: %d)\n", activities[i].index, activities[i].start, activities[i].finish);
+// --- 2c. Parallel Sort (Chunked Radix Sort + Stable Merges) ---
+
+static int parallelThreadCount(void) {
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    if (cores < 1) return 1;
+    return cores > PARALLEL_MAX_THREADS ? PARALLEL_MAX_THREADS : (int)cores;
+}
+
+/*
+ * A merge task writes dst[outBegin, outEnd) of the merge of the runs
+ * [begin, mid) and [mid, end), so one large merge can be shared by
+ * several threads.
+ */
+typedef struct {
+    Activity *src;
+    Activity *dst;
+    int begin;
+    int mid;
+    int end;
+    int outBegin;
+    int outEnd;
+    int ok;
+} SortTask;
+
+static void *radixSortWorker(void *arg) {
+    SortTask *task = (SortTask *)arg;
+    task->ok = radixSortActivities(task->src + task->begin, task->end - task->begin);
+    return NULL;
+}
+
+/*
+ * Merge path: how many of the first k merged elements come from the left
+ * run a[0, na), with b[0, nb) on the right and ties going left. Binary
+ * search on the diagonal, O(log n).
+ */
+static int mergeCoRank(const Activity *a, int na, const Activity *b, int nb, int k) {
+    int lo = k > nb ? k - nb : 0;
+    int hi = k < na ? k : na;
+    while (lo < hi) {
+        int i = lo + (hi - lo) / 2;
+        if (a[i].finish <= b[k - i - 1].finish) {
+            lo = i + 1; // a[i] is still among the first k
+        } else {
+            hi = i;
+        }
     }
-    
-    printf("\n--- Selected Activities (Greedy Schedule) ---\n");
-    
-    
-    printf("Selected Activity A%d (Start: %d, Finish: %d)\n", 
-           activities[0].index, activities[0].start, activities[0].finish);
+    return lo;
+}
 
-    
-    int last_finish_time = activities[0].finish;
+// Stable merge of the task's output slice: on equal finish times the left run goes first
+static void *mergeWorker(void *arg) {
+    SortTask *task = (SortTask *)arg;
+    const Activity *a = task->src + task->begin;
+    const Activity *b = task->src + task->mid;
+    int na = task->mid - task->begin, nb = task->end - task->mid;
+    int first = task->outBegin - task->begin, last = task->outEnd - task->begin;
+    int i = mergeCoRank(a, na, b, nb, first), iEnd = mergeCoRank(a, na, b, nb, last);
+    int j = first - i, jEnd = last - iEnd;
+    int k = task->outBegin;
+    while (i < iEnd && j < jEnd) {
+        if (b[j].finish < a[i].finish) {
+            task->dst[k++] = b[j++];
+        } else {
+            task->dst[k++] = a[i++];
+        }
+    }
+    while (i < iEnd) task->dst[k++] = a[i++];
+    while (j < jEnd) task->dst[k++] = b[j++];
+    return NULL;
+}
+
+// Runs one task per thread; a task that cannot get a thread runs on the caller
+static void runSortTasks(SortTask tasks[], int count, void *(*worker)(void *)) {
+    pthread_t tids[PARALLEL_MAX_THREADS];
+    int started[PARALLEL_MAX_THREADS];
+    for (int t = 0; t < count; t++) {
+        started[t] = (pthread_create(&tids[t], NULL, worker, &tasks[t]) == 0);
+        if (!started[t]) {
+            worker(&tasks[t]);
+        }
+    }
+    for (int t = 0; t < count; t++) {
+        if (started[t]) {
+            pthread_join(tids[t], NULL);
+        }
+    }
+}
+
+/*
+ * Each thread radix-sorts one chunk, then sorted runs are merged pairwise
+ * until one run is left. Every round keeps all threads busy: a round with
+ * m merges splits each merge's output into threads/m slices, and merge
+ * path co-ranking finds where each slice starts in both runs. Every step
+ * is stable, so the order matches the serial radix sort exactly.
+ */
+void parallelSortActivities(Activity activities[], int n) {
+    Activity *buffer = (Activity *)malloc((size_t)n * sizeof(Activity));
+    if (buffer == NULL) {
+        sortActivitiesByFinish(activities, n);
+        return;
+    }
+
+    int threads = parallelThreadCount();
+    int bounds[PARALLEL_MAX_THREADS + 1];
+    for (int t = 0; t <= threads; t++) {
+        bounds[t] = (int)((long long)n * t / threads);
+    }
+
+    SortTask tasks[PARALLEL_MAX_THREADS];
+    for (int t = 0; t < threads; t++) {
+        tasks[t] = (SortTask){ activities, NULL, bounds[t], bounds[t + 1], bounds[t + 1], 0, 0, 0 };
+    }
+    runSortTasks(tasks, threads, radixSortWorker);
+    for (int t = 0; t < threads; t++) {
+        if (!tasks[t].ok) {
+            // A chunk could not get its scratch buffer: sort everything serially
+            free(buffer);
+            sortActivitiesByFinish(activities, n);
+            return;
+        }
+    }
+
+    Activity *src = activities;
+    Activity *dst = buffer;
+    for (int width = 1; width < threads; width *= 2) {
+        int merges = (threads + 2 * width - 1) / (2 * width);
+        int slices = threads / merges > 1 ? threads / merges : 1;
+        int count = 0;
+        for (int t = 0; t < threads; t += 2 * width) {
+            int mid = t + width < threads ? t + width : threads;
+            int end = t + 2 * width < threads ? t + 2 * width : threads;
+            int length = bounds[end] - bounds[t];
+            for (int s = 0; s < slices; s++) {
+                tasks[count++] = (SortTask){ src, dst, bounds[t], bounds[mid], bounds[end],
+                                             bounds[t] + (int)((long long)length * s / slices),
+                                             bounds[t] + (int)((long long)length * (s + 1) / slices), 1 };
+            }
+        }
+        runSortTasks(tasks, count, mergeWorker);
+        Activity *tmp = src;
+        src = dst;
+        dst = tmp;
+    }
+
+    if (src != activities) {
+        memcpy(activities, src, (size_t)n * sizeof(Activity));
+    }
+    free(buffer);
+}
+
+// --- 3. The Greedy Algorithm Implementation ---
+
+/*
+ * Marks the greedy schedule over activities sorted by finish time:
+ * selected[i] = 1 if activity i is taken. Returns the number selected.
+ */
+int greedySelect(const Activity activities[], int n, char selected[]) {
+    // The first activity is always taken
+    ActivityTime last_finish_time = activities[0].finish;
     int selected_count = 1;
+    selected[0] = 1;
 
-    
     for (int i = 1; i < n; i++) {
-        
-        
-        if (activities[i].start >= last_finish_time) {
-            
-            
-            printf("Selected Activity A%d (Start: %d, Finish: %d)\n", 
-                   activities[i].index, activities[i].start, activities[i].finish);
-            
-            
+        selected[i] = (activities[i].start >= last_finish_time);
+        if (selected[i]) {
             last_finish_time = activities[i].finish;
             selected_count++;
         }
     }
+    return selected_count;
+}
+
+/*
+ * Parallel greedy scan. Each thread first runs the greedy chain of its own
+ * chunk as if nothing came before it. The serial stitch then walks each
+ * chunk with the real last finish time from the previous chunk. As soon as
+ * the walk selects an activity that is already on the chunk's own chain,
+ * both chains continue identically, so the rest of the chunk is reused.
+ * The result is exactly the serial greedy selection.
+ */
+typedef struct {
+    const Activity *activities;
+    char *selected;
+    int begin;
+    int end;
+} ScanTask;
+
+static void *scanWorker(void *arg) {
+    ScanTask *task = (ScanTask *)arg;
+    if (task->end > task->begin) {
+        greedySelect(task->activities + task->begin, task->end - task->begin, task->selected + task->begin);
+    }
+    return NULL;
+}
+
+int parallelGreedySelect(const Activity activities[], int n, char selected[]) {
+    int threads = parallelThreadCount();
+    if (n < threads) {
+        return greedySelect(activities, n, selected);
+    }
+
+    pthread_t tids[PARALLEL_MAX_THREADS];
+    int started[PARALLEL_MAX_THREADS];
+    ScanTask tasks[PARALLEL_MAX_THREADS];
+
+    for (int t = 0; t < threads; t++) {
+        tasks[t] = (ScanTask){ activities, selected,
+                               (int)((long long)n * t / threads),
+                               (int)((long long)n * (t + 1) / threads) };
+        started[t] = (pthread_create(&tids[t], NULL, scanWorker, &tasks[t]) == 0);
+        if (!started[t]) {
+            scanWorker(&tasks[t]);
+        }
+    }
+    for (int t = 0; t < threads; t++) {
+        if (started[t]) {
+            pthread_join(tids[t], NULL);
+        }
+    }
+
+    // Serial stitch: chunk 0 already holds the true chain
+    int last = -1; // Last selected activity so far
+    for (int i = tasks[0].end - 1; i >= 0 && last == -1; i--) {
+        if (selected[i]) last = i;
+    }
+    for (int t = 1; t < threads; t++) {
+        for (int i = tasks[t].begin; i < tasks[t].end; i++) {
+            if (activities[i].start >= activities[last].finish) {
+                if (selected[i]) {
+                    break; // Joined the chunk's own chain
+                }
+                selected[i] = 1;
+                last = i;
+            } else {
+                selected[i] = 0;
+            }
+        }
+        // The chunk's last mark is the chain's last selected activity
+        for (int i = tasks[t].end - 1; i >= tasks[t].begin; i--) {
+            if (selected[i]) {
+                last = i;
+                break;
+            }
+        }
+    }
+
+    int selected_count = 0;
+    for (int i = 0; i < n; i++) {
+        selected_count += selected[i];
+    }
+    return selected_count;
+}
+
+/*
+ * Sorts the activities by finish time and stores the positions (in the
+ * sorted array) of the greedy schedule in selected[], which must have
+ * room for n entries. Returns the number selected, or -1 if memory
+ * allocation failed.
+ */
+int activity_selector(Activity activities[], int n, int selected[]) {
+    if (n <= 0) {
+        return 0;
+    }
+
+    char *taken = (char *)malloc((size_t)n);
+    if (taken == NULL) {
+        return -1;
+    }
+
+    int parallel = (n >= PARALLEL_THRESHOLD);
+    if (parallel) {
+        parallelSortActivities(activities, n);
+    } else {
+        sortActivitiesByFinish(activities, n);
+    }
+    if (parallel) {
+        parallelGreedySelect(activities, n, taken);
+    } else {
+        greedySelect(activities, n, taken);
+    }
+
+    int selected_count = 0;
+    for (int i = 0; i < n; i++) {
+        if (taken[i]) {
+            selected[selected_count++] = i;
+        }
+    }
+
+    free(taken);
+    return selected_count;
+}
+
+void reportActivitySelection(const Activity activities[], int n, const int selected[], int selected_count) {
+    if (n <= 0) {
+        REPORT(VERBOSITY_SUMMARY, "No activities to select.\n");
+        return;
+    }
+
+    REPORT(VERBOSITY_FULL, "\n--- Sorted Activities (by Finish Time) ---\n");
+    for (int i = 0; verbosity == VERBOSITY_FULL && i < n; i++) {
+        printf("A%d: (Start: " TIME_FMT ", Finish: " TIME_FMT ")\n", activities[i].index, activities[i].start, activities[i].finish);
+    }
     
-    printf("\n========================================================\n");
-    printf("Maximum number of non-overlapping activities selected: %d\n", selected_count);
+    REPORT(VERBOSITY_FULL, "\n--- Selected Activities (Greedy Schedule) ---\n");
+    for (int i = 0; verbosity == VERBOSITY_FULL && i < selected_count; i++) {
+        const Activity *a = &activities[selected[i]];
+        printf("Selected Activity A%d (Start: " TIME_FMT ", Finish: " TIME_FMT ")\n", 
+               a->index, a->start, a->finish);
+    }
+    
+    REPORT(VERBOSITY_SUMMARY, "\n========================================================\n");
+    REPORT(VERBOSITY_SUMMARY, "Maximum number of non-overlapping activities selected: %d\n", selected_count);
+}
+
+// --- 4. Interval Partitioning (Multiple Rooms / Machines) ---
+
+int compareActivitiesByStart(const void *a, const void *b) {
+    const Activity *activityA = (const Activity *)a;
+    const Activity *activityB = (const Activity *)b;
+    return (activityA->start > activityB->start) - (activityA->start < activityB->start);
+}
+
+void sortActivitiesByStart(Activity activities[], int n) {
+    if (n >= RADIX_SORT_THRESHOLD && radixSortActivitiesBy(activities, n, 1)) {
+        return;
+    }
+    qsort(activities, n, sizeof(Activity), compareActivitiesByStart);
+}
+
+/*
+ * Array-backed d-ary min-heap of rooms keyed by the finish time of their
+ * last activity. With HEAP_ARITY children per node the tree is shallower
+ * than a binary heap and each sift-down compares siblings that sit next
+ * to each other in memory.
+ */
+typedef struct {
+    ActivityTime finish;
+    int room;
+} RoomSlot;
+
+typedef struct {
+    RoomSlot *slots;
+    int size;
+    int capacity;
+} RoomHeap;
+
+static void roomHeapSiftUp(RoomHeap *heap, int i) {
+    RoomSlot item = heap->slots[i];
+    while (i > 0) {
+        int parent = (i - 1) / HEAP_ARITY;
+        if (heap->slots[parent].finish <= item.finish) break;
+        heap->slots[i] = heap->slots[parent];
+        i = parent;
+    }
+    heap->slots[i] = item;
+}
+
+static void roomHeapSiftDown(RoomHeap *heap, int i) {
+    RoomSlot item = heap->slots[i];
+    for (;;) {
+        int first = i * HEAP_ARITY + 1;
+        if (first >= heap->size) break;
+        int last = first + HEAP_ARITY < heap->size ? first + HEAP_ARITY : heap->size;
+        int smallest = first;
+        for (int c = first + 1; c < last; c++) {
+            if (heap->slots[c].finish < heap->slots[smallest].finish) smallest = c;
+        }
+        if (heap->slots[smallest].finish >= item.finish) break;
+        heap->slots[i] = heap->slots[smallest];
+        i = smallest;
+    }
+    heap->slots[i] = item;
+}
+
+static int roomHeapPush(RoomHeap *heap, RoomSlot item) {
+    if (heap->size == heap->capacity) {
+        int capacity = heap->capacity ? heap->capacity * 2 : 16;
+        RoomSlot *grown = (RoomSlot *)realloc(heap->slots, (size_t)capacity * sizeof(RoomSlot));
+        if (grown == NULL) {
+            return 0;
+        }
+        heap->slots = grown;
+        heap->capacity = capacity;
+    }
+    heap->slots[heap->size++] = item;
+    roomHeapSiftUp(heap, heap->size - 1);
+    return 1;
+}
+
+/*
+ * Assigns every activity to the fewest rooms. Activities are sorted by
+ * start time; each one reuses the room that frees up earliest if it is
+ * already free, otherwise it opens a new room. O(n log k) for k rooms.
+ * On return activities[] is in start order and room[i] is the room
+ * (0-based) of activities[i]. Returns the number of rooms, or -1 if
+ * memory allocation failed.
+ */
+int partitionIntoRooms(Activity activities[], int n, int room[]) {
+    RoomHeap heap = { NULL, 0, 0 };
+
+    sortActivitiesByStart(activities, n);
+
+    for (int i = 0; i < n; i++) {
+        if (heap.size > 0 && heap.slots[0].finish <= activities[i].start) {
+            // Reuse the earliest-free room: replace the top and sift it down
+            room[i] = heap.slots[0].room;
+            heap.slots[0].finish = activities[i].finish;
+            roomHeapSiftDown(&heap, 0);
+        } else {
+            room[i] = heap.size;
+            RoomSlot opened = { activities[i].finish, heap.size };
+            if (!roomHeapPush(&heap, opened)) {
+                free(heap.slots);
+                return -1;
+            }
+        }
+    }
+
+    int rooms = heap.size;
+    free(heap.slots);
+    return rooms;
+}
+
+// Coin flips from a xorshift generator: level l is reached with probability 2^-l
+static int randomLevel(uint64_t *rng) {
+    *rng ^= *rng << 13;
+    *rng ^= *rng >> 7;
+    *rng ^= *rng << 17;
+    uint64_t bits = *rng;
+    int level = 1;
+    while ((bits & 1) && level < SKIP_MAX_LEVEL) {
+        level++;
+        bits >>= 1;
+    }
+    return level;
+}
+
+/*
+ * Busy machines in a skip list ordered by (finish, order of becoming
+ * busy). Each machine owns one node for the whole run.
+ */
+typedef struct MachineNode {
+    ActivityTime finish;
+    long seq;
+    int id;
+    int level;
+    struct MachineNode *next[];
+} MachineNode;
+
+static inline int machineLess(const MachineNode *a, const MachineNode *b) {
+    if (a->finish != b->finish) {
+        return a->finish < b->finish;
+    }
+    return a->seq < b->seq;
+}
+
+/*
+ * Schedules as many activities as possible onto k machines. Activities
+ * must be sorted by finish time (as left by activity_selector). Each
+ * activity goes to the busy machine whose last finish is the latest one
+ * not after its start (best fit), else to an idle machine, else it is
+ * skipped. The new finish is always the largest so far, so the chosen
+ * machine's node is unlinked and appended at the end of the skip list:
+ * O(log k) expected per activity, O(n log k) overall. machine[i] is -1
+ * for skipped activities. Returns the number scheduled, or -1 if
+ * allocation failed.
+ */
+int scheduleOnMachines(const Activity activities[], int n, int k, int machine[]) {
+    MachineNode *head = (MachineNode *)calloc(1, sizeof(MachineNode) + SKIP_MAX_LEVEL * sizeof(MachineNode *));
+    if (head == NULL) {
+        return -1;
+    }
+    MachineNode *tail[SKIP_MAX_LEVEL]; // Last node at each level, where appends go
+    for (int l = 0; l < SKIP_MAX_LEVEL; l++) {
+        tail[l] = head;
+    }
+    int top = 1;
+    int used = 0; // Machines become busy in id order, so the next idle one is 'used'
+    long seq = 0;
+    uint64_t rng = 0x9E3779B97F4A7C15ULL;
+    int scheduled = 0;
+
+    for (int i = 0; i < n; i++) {
+        // Last busy machine free by activities[i].start
+        MachineNode *node = head;
+        for (int l = top - 1; l >= 0; l--) {
+            while (node->next[l] != NULL && node->next[l]->finish <= activities[i].start) {
+                node = node->next[l];
+            }
+        }
+        MachineNode *chosen = (node != head) ? node : NULL;
+
+        if (chosen != NULL) {
+            // Unlink it from every level it is on
+            node = head;
+            for (int l = top - 1; l >= 0; l--) {
+                while (node->next[l] != chosen && node->next[l] != NULL && machineLess(node->next[l], chosen)) {
+                    node = node->next[l];
+                }
+                if (l < chosen->level) {
+                    node->next[l] = chosen->next[l];
+                    if (tail[l] == chosen) {
+                        tail[l] = node;
+                    }
+                }
+            }
+        } else if (used < k) {
+            int level = randomLevel(&rng);
+            chosen = (MachineNode *)malloc(sizeof(MachineNode) + (size_t)level * sizeof(MachineNode *));
+            if (chosen == NULL) {
+                scheduled = -1;
+                break;
+            }
+            chosen->id = used++;
+            chosen->level = level;
+            if (level > top) top = level;
+        } else {
+            machine[i] = -1;
+            continue;
+        }
+
+        chosen->finish = activities[i].finish;
+        chosen->seq = seq++;
+        for (int l = 0; l < chosen->level; l++) {
+            chosen->next[l] = NULL;
+            tail[l]->next[l] = chosen;
+            tail[l] = chosen;
+        }
+        machine[i] = chosen->id;
+        scheduled++;
+    }
+
+    MachineNode *node = head->next[0];
+    while (node != NULL) {
+        MachineNode *next = node->next[0];
+        free(node);
+        node = next;
+    }
+    free(head);
+    return scheduled;
+}
+
+// --- 5. Online Activity Selection ---
+/*
+ * Activities live in a skip list ordered by (finish, insertion order).
+ * The greedy chain is a second skip list threaded through the same nodes,
+ * so each node carries two towers of links: [0, level) for all activities
+ * and [level, 2 * level) for the chain.
+ *
+ * An update only changes the chain from the point where it touches it:
+ *  - Inserting x: x is taken iff x.start >= finish of the chain element
+ *    before it. If it is, the chain is re-walked forward from x.
+ *  - Removing x: nothing changes unless x was on the chain; then the chain
+ *    is re-walked from x's successor.
+ * A re-walk stops as soon as it selects a node that is already on the
+ * chain, since the greedy chain from there on is the same.
+ *
+ * Each activity link also stores the latest start among the nodes it
+ * skips over. The re-walk uses these to jump straight to the next
+ * activity that starts late enough, in O(log n), and drops the chain
+ * nodes it passes on the way. An update therefore costs O(log n) per
+ * chain element that actually changes, and the maximum size is kept
+ * as a counter.
+ */
+typedef struct ScheduleNode {
+    Activity activity;
+    long seq;       // Insertion order, breaks ties between equal finish times
+    int onChain;
+    int level;
+    // 'level' activity links, then 'level' chain links, then 'level' span maxima
+    struct ScheduleNode *links[];
+} ScheduleNode;
+
+typedef struct {
+    ScheduleNode *head; // Sentinel with SKIP_MAX_LEVEL links in both lists
+    int level;          // Highest level in use
+    int chainLevel;
+    long nextSeq;
+    int size;
+    int chainSize;      // Current maximum number of non-overlapping activities
+    uint64_t rng;
+} OnlineSelector;
+
+#define ACT_LINK(node, l) ((node)->links[(l)])
+#define CHAIN_LINK(node, l) ((node)->links[(node)->level + (l)])
+// Latest start among the nodes after 'node' up to and including ACT_LINK(node, l)
+#define SPAN_MAX(node, l) (((ActivityTime *)((node)->links + 2 * (node)->level))[l])
+
+static ScheduleNode *createScheduleNode(int level) {
+    ScheduleNode *node = (ScheduleNode *)calloc(1, sizeof(ScheduleNode) + 2 * (size_t)level * sizeof(ScheduleNode *) +
+                                                   (size_t)level * sizeof(ActivityTime));
+    if (node != NULL) {
+        node->level = level;
+        for (int l = 0; l < level; l++) {
+            SPAN_MAX(node, l) = TIME_MIN; // Nothing skipped yet
+        }
+    }
+    return node;
+}
+
+OnlineSelector *createOnlineSelector(void) {
+    OnlineSelector *S = (OnlineSelector *)calloc(1, sizeof(OnlineSelector));
+    if (S == NULL) {
+        return NULL;
+    }
+    S->head = createScheduleNode(SKIP_MAX_LEVEL);
+    if (S->head == NULL) {
+        free(S);
+        return NULL;
+    }
+    S->level = 1;
+    S->chainLevel = 1;
+    S->rng = 0x9E3779B97F4A7C15ULL;
+    return S;
+}
+
+void freeOnlineSelector(OnlineSelector *S) {
+    if (S == NULL) return;
+    ScheduleNode *node = ACT_LINK(S->head, 0);
+    while (node != NULL) {
+        ScheduleNode *next = ACT_LINK(node, 0);
+        free(node);
+        node = next;
+    }
+    free(S->head);
+    free(S);
 }
 
-int main() {
+static inline int scheduleLess(const ScheduleNode *a, const ScheduleNode *b) {
+    if (a->activity.finish != b->activity.finish) {
+        return a->activity.finish < b->activity.finish;
+    }
+    return a->seq < b->seq;
+}
+
+// Fills update[l] with the last node before 'key' at each level of one list
+static void findPredecessors(OnlineSelector *S, const ScheduleNode *key, int chain, ScheduleNode *update[]) {
+    ScheduleNode *node = S->head;
+    int top = chain ? S->chainLevel : S->level;
+    for (int l = top - 1; l >= 0; l--) {
+        for (;;) {
+            ScheduleNode *next = chain ? CHAIN_LINK(node, l) : ACT_LINK(node, l);
+            if (next == NULL || !scheduleLess(next, key)) break;
+            node = next;
+        }
+        update[l] = node;
+    }
+}
+
+// Recomputes SPAN_MAX(u, l) from the level below, which must already be up to date
+static void refreshSpan(ScheduleNode *u, int l) {
+    ScheduleNode *end = ACT_LINK(u, l);
+    ActivityTime latest = TIME_MIN;
+    if (l == 0) {
+        if (end != NULL) latest = end->activity.start;
+    } else {
+        for (ScheduleNode *v = u; v != end; v = ACT_LINK(v, l - 1)) {
+            if (SPAN_MAX(v, l - 1) > latest) latest = SPAN_MAX(v, l - 1);
+        }
+    }
+    SPAN_MAX(u, l) = latest;
+}
+
+static void linkNode(OnlineSelector *S, ScheduleNode *x, int chain) {
+    ScheduleNode *update[SKIP_MAX_LEVEL];
+    int *top = chain ? &S->chainLevel : &S->level;
+    findPredecessors(S, x, chain, update);
+    for (int l = *top; l < x->level; l++) {
+        update[l] = S->head;
+    }
+    if (x->level > *top) {
+        *top = x->level;
+    }
+    for (int l = 0; l < x->level; l++) {
+        if (chain) {
+            CHAIN_LINK(x, l) = CHAIN_LINK(update[l], l);
+            CHAIN_LINK(update[l], l) = x;
+        } else {
+            ACT_LINK(x, l) = ACT_LINK(update[l], l);
+            ACT_LINK(update[l], l) = x;
+        }
+    }
+    // Only the spans around x changed; fix them bottom-up
+    for (int l = 0; !chain && l < S->level; l++) {
+        if (l < x->level) {
+            refreshSpan(x, l);
+        }
+        refreshSpan(update[l], l);
+    }
+}
+
+static void unlinkNode(OnlineSelector *S, ScheduleNode *x, int chain) {
+    ScheduleNode *update[SKIP_MAX_LEVEL];
+    findPredecessors(S, x, chain, update);
+    for (int l = 0; l < x->level; l++) {
+        if (chain) {
+            CHAIN_LINK(update[l], l) = CHAIN_LINK(x, l);
+        } else {
+            ACT_LINK(update[l], l) = ACT_LINK(x, l);
+        }
+    }
+    for (int l = 0; !chain && l < S->level; l++) {
+        refreshSpan(update[l], l);
+    }
+}
+
+// Last chain node ordered before x, or NULL
+static ScheduleNode *chainPredecessor(OnlineSelector *S, const ScheduleNode *x) {
+    ScheduleNode *update[SKIP_MAX_LEVEL];
+    findPredecessors(S, x, 1, update);
+    return update[0] == S->head ? NULL : update[0];
+}
+
+static void setOnChain(OnlineSelector *S, ScheduleNode *x, int onChain) {
+    if (x->onChain == onChain) return;
+    if (onChain) {
+        linkNode(S, x, 1);
+        S->chainSize++;
+    } else {
+        unlinkNode(S, x, 1);
+        S->chainSize--;
+    }
+    x->onChain = onChain;
+}
+
+/*
+ * First activity at or after 'from' (in finish order) with start >= t,
+ * or NULL. Climbs from 'from' over whole spans that start too early,
+ * then descends into the span that holds the answer: O(log n) expected.
+ */
+static ScheduleNode *nextStartingAt(ScheduleNode *from, ActivityTime t) {
+    if (from == NULL || from->activity.start >= t) {
+        return from;
+    }
+    ScheduleNode *node = from;
+    int l = node->level - 1;
+    while (SPAN_MAX(node, l) < t) {
+        node = ACT_LINK(node, l);
+        if (node == NULL) {
+            return NULL; // Everything after 'from' starts too early
+        }
+        l = node->level - 1;
+    }
+    while (l > 0) {
+        l--;
+        while (SPAN_MAX(node, l) < t) {
+            node = ACT_LINK(node, l);
+        }
+    }
+    return ACT_LINK(node, 0);
+}
+
+// Re-runs the greedy choice from 'node' until it rejoins the existing chain
+static void repairChain(OnlineSelector *S, ScheduleNode *node, ScheduleNode *prev) {
+    for (;;) {
+        ScheduleNode *next = (prev == NULL) ? node : nextStartingAt(node, prev->activity.finish);
+        // Chain nodes before the next pick are no longer selected
+        ScheduleNode *stale = (prev == NULL) ? CHAIN_LINK(S->head, 0) : CHAIN_LINK(prev, 0);
+        while (stale != NULL && (next == NULL || scheduleLess(stale, next))) {
+            ScheduleNode *following = CHAIN_LINK(stale, 0);
+            setOnChain(S, stale, 0);
+            stale = following;
+        }
+        if (next == NULL || next->onChain) {
+            return; // Same chain from here on
+        }
+        setOnChain(S, next, 1);
+        prev = next;
+        node = ACT_LINK(next, 0);
+    }
+}
+
+// Adds an activity; the returned handle is used to remove it later (NULL on allocation failure)
+ScheduleNode *onlineInsert(OnlineSelector *S, Activity activity) {
+    ScheduleNode *x = createScheduleNode(randomLevel(&S->rng));
+    if (x == NULL) {
+        return NULL;
+    }
+    x->activity = activity;
+    x->seq = S->nextSeq++;
+    linkNode(S, x, 0);
+    S->size++;
+
+    ScheduleNode *prev = chainPredecessor(S, x);
+    if (prev == NULL || activity.start >= prev->activity.finish) {
+        repairChain(S, x, prev);
+    }
+    return x;
+}
+
+void onlineRemove(OnlineSelector *S, ScheduleNode *x) {
+    ScheduleNode *successor = ACT_LINK(x, 0);
+    int wasOnChain = x->onChain;
+
+    setOnChain(S, x, 0);
+    unlinkNode(S, x, 0);
+    S->size--;
+
+    if (wasOnChain) {
+        repairChain(S, successor, chainPredecessor(S, x));
+    }
+    free(x);
+}
+
+static int compareScheduleNodes(const void *a, const void *b) {
+    const ScheduleNode *x = *(ScheduleNode *const *)a;
+    const ScheduleNode *y = *(ScheduleNode *const *)b;
+    return scheduleLess(x, y) ? -1 : scheduleLess(y, x);
+}
+
+/*
+ * Fills an empty selector with n activities at once instead of n inserts.
+ * The nodes are sorted once and every level is linked left to right. The
+ * greedy chain is threaded through in the same sweep, and the span
+ * maxima are filled in bottom-up: O(n log n) for the sort, O(n) for the
+ * rest. nodes[i] receives the handle of activities[i]. Returns 0, or -1
+ * if memory allocation failed.
+ */
+int onlineBuild(OnlineSelector *S, const Activity activities[], int n, ScheduleNode *nodes[]) {
+    ScheduleNode **order = (ScheduleNode **)malloc(((size_t)n + 1) * sizeof(ScheduleNode *));
+    if (order == NULL) {
+        return -1;
+    }
+    for (int i = 0; i < n; i++) {
+        nodes[i] = createScheduleNode(randomLevel(&S->rng));
+        if (nodes[i] == NULL) {
+            while (i-- > 0) free(nodes[i]);
+            free(order);
+            return -1;
+        }
+        nodes[i]->activity = activities[i];
+        nodes[i]->seq = S->nextSeq++;
+        order[i] = nodes[i];
+    }
+    qsort(order, (size_t)n, sizeof(ScheduleNode *), compareScheduleNodes);
+
+    ScheduleNode *last[SKIP_MAX_LEVEL];
+    ScheduleNode *lastOnChain[SKIP_MAX_LEVEL];
+    for (int l = 0; l < SKIP_MAX_LEVEL; l++) {
+        last[l] = S->head;
+        lastOnChain[l] = S->head;
+    }
+    for (int i = 0; i < n; i++) {
+        ScheduleNode *x = order[i];
+        for (int l = 0; l < x->level; l++) {
+            ACT_LINK(last[l], l) = x;
+            last[l] = x;
+        }
+        if (x->level > S->level) S->level = x->level;
+
+        const ScheduleNode *prev = lastOnChain[0];
+        if (prev == S->head || x->activity.start >= prev->activity.finish) {
+            for (int l = 0; l < x->level; l++) {
+                CHAIN_LINK(lastOnChain[l], l) = x;
+                lastOnChain[l] = x;
+            }
+            if (x->level > S->chainLevel) S->chainLevel = x->level;
+            x->onChain = 1;
+            S->chainSize++;
+        }
+    }
+    S->size = n;
+
+    for (int l = 0; l < S->level; l++) {
+        for (ScheduleNode *u = S->head; u != NULL; u = ACT_LINK(u, l)) {
+            refreshSpan(u, l);
+        }
+    }
+    free(order);
+    return 0;
+}
+
+// O(1): the current maximum number of non-overlapping activities
+static inline int onlineSelectedCount(const OnlineSelector *S) {
+    return S->chainSize;
+}
+
+// Copies the current selection, in finish order, into 'out' (room for onlineSelectedCount)
+int onlineSelectedSet(const OnlineSelector *S, Activity out[]) {
+    int count = 0;
+    for (ScheduleNode *node = CHAIN_LINK(S->head, 0); node != NULL; node = CHAIN_LINK(node, 0)) {
+        out[count++] = node->activity;
+    }
+    return count;
+}
+
+static int runOnlineUpdates(Activity activities[], int n) {
+    OnlineSelector *S = createOnlineSelector();
+    int capacity = n + 16;
+    int labels = n; // Activities are labelled A1..A<labels>
+    ScheduleNode **handles = (ScheduleNode **)calloc((size_t)capacity + 1, sizeof(ScheduleNode *));
+    Activity *selection = NULL;
+    int status = 0;
+
+    if (S == NULL || handles == NULL) {
+        printf("Error: Memory allocation failed.\n");
+        free(handles);
+        freeOnlineSelector(S);
+        return 1;
+    }
+    // Bulk-build, then file each node under its label
+    ScheduleNode **built = (ScheduleNode **)malloc((size_t)n * sizeof(ScheduleNode *));
+    if (built == NULL || onlineBuild(S, activities, n, built) != 0) {
+        printf("Error: Memory allocation failed.\n");
+        free(built);
+        status = 1;
+        goto cleanup;
+    }
+    for (int i = 0; i < n; i++) {
+        handles[activities[i].index] = built[i];
+    }
+    free(built);
+
+    REPORT(VERBOSITY_SUMMARY, "\n--- Online Updates ---\n");
+    REPORT(VERBOSITY_FULL, "Enter '+ s f' to add an activity, '- k' to remove activity Ak, or 'q' to quit.\n");
+    char op;
+    while (scanf(" %c", &op) == 1 && op != 'q') {
+        if (op == '+') {
+            Activity a;
+            if (scanf(TIME_FMT " " TIME_FMT, &a.start, &a.finish) != 2 || a.finish < a.start) {
+                printf("Invalid activity. Stopping updates.\n");
+                break;
+            }
+            if (labels == capacity) {
+                ScheduleNode **grown = (ScheduleNode **)realloc(handles, ((size_t)capacity * 2 + 1) * sizeof(ScheduleNode *));
+                if (grown == NULL) {
+                    printf("Error: Memory allocation failed.\n");
+                    status = 1;
+                    break;
+                }
+                handles = grown;
+                capacity *= 2;
+            }
+            a.index = ++labels;
+            handles[a.index] = onlineInsert(S, a);
+            if (handles[a.index] == NULL) {
+                printf("Error: Memory allocation failed.\n");
+                status = 1;
+                break;
+            }
+            REPORT(VERBOSITY_SUMMARY, "Added A%d.", a.index);
+        } else if (op == '-') {
+            int k;
+            if (scanf("%d", &k) != 1 || k < 1 || k > labels || handles[k] == NULL) {
+                printf("Invalid activity label. Stopping updates.\n");
+                break;
+            }
+            onlineRemove(S, handles[k]);
+            handles[k] = NULL;
+            REPORT(VERBOSITY_SUMMARY, "Removed A%d.", k);
+        } else {
+            printf("Invalid update. Stopping updates.\n");
+            break;
+        }
+        REPORT(VERBOSITY_SUMMARY, " Maximum non-overlapping activities: %d\n", onlineSelectedCount(S));
+    }
+
+    selection = (Activity *)malloc(((size_t)onlineSelectedCount(S) + 1) * sizeof(Activity));
+    if (selection != NULL && verbosity == VERBOSITY_FULL) {
+        int count = onlineSelectedSet(S, selection);
+        printf("\n--- Current Selection ---\n");
+        for (int i = 0; i < count; i++) {
+            printf("Selected Activity A%d (Start: " TIME_FMT ", Finish: " TIME_FMT ")\n",
+                   selection[i].index, selection[i].start, selection[i].finish);
+        }
+    }
+    free(selection);
+
+cleanup:
+    free(handles);
+    freeOnlineSelector(S);
+    return status;
+}
+
+int main(int argc, char *argv[]) {
     int n;
+
+    setVerbosity(argc, argv);
     
-    printf("--- Activity Selection Problem using Greedy Algorithm ---\n");
-    printf("Enter the number of activities (n): ");
+    REPORT(VERBOSITY_SUMMARY, "--- Activity Selection Problem using Greedy Algorithm ---\n");
+    REPORT(VERBOSITY_FULL, "Enter the number of activities (n): ");
     
     if (scanf("%d", &n) != 1 || n <= 0) {
         printf("Error: Please enter a positive number of activities.\n");
@@ -83,33 +1147,88 @@ int main() {
         return 1;
     }
 
-    printf("\n--- Enter Start and Finish Times ---\n");
+    REPORT(VERBOSITY_FULL, "\n--- Enter Start and Finish Times ---\n");
     for (int i = 0; i < n; i++) {
         activities[i].index = i + 1; // Assign A1, A2, A3, etc.
         
-        printf("Activity %d (A%d):\n", i + 1, i + 1);
-        printf("  Start time (s[%d]): ", i + 1);
-        if (scanf("%d", &activities[i].start) != 1) {
+        REPORT(VERBOSITY_FULL, "Activity %d (A%d):\n", i + 1, i + 1);
+        REPORT(VERBOSITY_FULL, "  Start time (s[%d]): ", i + 1);
+        if (scanf(TIME_FMT, &activities[i].start) != 1) {
             printf("Invalid input. Exiting.\n");
             free(activities);
             return 1;
         }
 
-        printf("  Finish time (f[%d]): ", i + 1);
-        if (scanf("%d", &activities[i].finish) != 1 || activities[i].finish < activities[i].start) {
+        REPORT(VERBOSITY_FULL, "  Finish time (f[%d]): ", i + 1);
+        if (scanf(TIME_FMT, &activities[i].finish) != 1 || activities[i].finish < activities[i].start) {
              printf("Invalid input. Finish time must be valid and >= Start time. Exiting.\n");
              free(activities);
              return 1;
         }
     }
 
-    activity_selector(activities, n);
+    // The result buffer is reused for the selection, machine and room assignments
+    int *assignment = (int *)malloc((size_t)n * sizeof(int));
+    if (assignment == NULL) {
+        printf("Error: Memory allocation failed.\n");
+        free(activities);
+        return 1;
+    }
+
+    int selected_count = activity_selector(activities, n, assignment);
+    if (selected_count < 0) {
+        printf("Error: Memory allocation failed.\n");
+        free(assignment);
+        free(activities);
+        return 1;
+    }
+    reportActivitySelection(activities, n, assignment, selected_count);
+
+    REPORT(VERBOSITY_SUMMARY, "Time Complexity Analysis: O(n log n) due to the sorting step.\n");
+    REPORT(VERBOSITY_SUMMARY, "========================================================\n");
+
+    // Most activities on k machines (reuses the finish-sorted array); optional
+    int k = 0;
+    REPORT(VERBOSITY_FULL, "\nEnter the number of machines (k) for multi-machine scheduling (0 to skip): ");
+    if (scanf("%d", &k) == 1 && k > 0) {
+        int scheduled = scheduleOnMachines(activities, n, k, assignment);
+        if (scheduled < 0) {
+            printf("Error: Memory allocation failed.\n");
+            free(assignment);
+            free(activities);
+            return 1;
+        }
+        REPORT(VERBOSITY_SUMMARY, "\n--- Schedule on %d Machine(s) ---\n", k);
+        for (int i = 0; verbosity == VERBOSITY_FULL && i < n; i++) {
+            if (assignment[i] >= 0) {
+                printf("A%d -> Machine %d\n", activities[i].index, assignment[i] + 1);
+            }
+        }
+        REPORT(VERBOSITY_SUMMARY, "Activities scheduled: %d of %d\n", scheduled, n);
+    }
 
-    printf("Time Complexity Analysis: O(n log n) due to the sorting step.\n");
-    printf("========================================================\n");
+    // Fewest rooms for all activities (re-sorts by start time)
+    int rooms = partitionIntoRooms(activities, n, assignment);
+    if (rooms < 0) {
+        printf("Error: Memory allocation failed.\n");
+        free(assignment);
+        free(activities);
+        return 1;
+    }
+    REPORT(VERBOSITY_SUMMARY, "\n--- Interval Partitioning (Fewest Rooms) ---\n");
+    for (int i = 0; verbosity == VERBOSITY_FULL && i < n; i++) {
+        printf("A%d (Start: " TIME_FMT ", Finish: " TIME_FMT ") -> Room %d\n",
+               activities[i].index, activities[i].start, activities[i].finish, assignment[i] + 1);
+    }
+    REPORT(VERBOSITY_SUMMARY, "Rooms needed: %d\n", rooms);
+    REPORT(VERBOSITY_SUMMARY, "========================================================\n");
+    free(assignment);
+
+    // Keep the schedule up to date as activities arrive and leave
+    int status = runOnlineUpdates(activities, n);
 
     // Free the allocated memory
     free(activities);
     
-    return 0;
+    return status;
 }
@@ -1,11 +1,82 @@
+#define _POSIX_C_SOURCE 200809L // isatty
 #include <stdio.h>
 #include <stdlib.h> 
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <math.h>
+#ifdef __AVX__
+#include <immintrin.h>
+#endif
+
+// stdout buffer used when input is not typed at a terminal
+#define OUTPUT_BUFFER_SIZE (1 << 20)
+// Capacity queries are answered on QUERY_THREADS (build with -pthread) once a batch reaches QUERY_PARALLEL_MIN
+#define QUERY_THREADS 4
+#define QUERY_PARALLEL_MIN 4096
+// Alignment of the structure-of-arrays columns (one cache line, >= one AVX vector)
+#define SOA_ALIGNMENT 64
+
+// --- 0. Output Verbosity ---
+/*
+ * The knapsack engines never print; they fill a caller-provided fractions
+ * buffer and reportKnapsack decides what to show. Chosen on the command line:
+ *   -q  silent  (errors only)
+ *   -s  summary (the final profit)
+ *   -v  full    (every item and step, the default)
+ */
+typedef enum {
+    VERBOSITY_SILENT,
+    VERBOSITY_SUMMARY,
+    VERBOSITY_FULL
+} Verbosity;
+
+static Verbosity verbosity = VERBOSITY_FULL;
+
+#define REPORT(level, ...) do { if (verbosity >= (level)) printf(__VA_ARGS__); } while (0)
+
+/*
+ * Selection engines, chosen with "-e sort|select|heap|soa":
+ *   sort    O(n log n)      sort every item by ratio (default)
+ *   select  O(n) expected   quickselect for the critical ratio
+ *   heap    O(n + k log n)  heapify, then pop only the k items taken
+ *   soa     O(n log n)      double-precision columns, SIMD ratios, sorts keys only
+ */
+typedef enum {
+    ENGINE_SORT,
+    ENGINE_SELECT,
+    ENGINE_HEAP,
+    ENGINE_SOA
+} KnapsackEngine;
+
+static KnapsackEngine engine = ENGINE_SORT;
+
+static void parseOptions(int argc, char *argv[]) {
+    for (int a = 1; a < argc; a++) {
+        if (strcmp(argv[a], "-q") == 0) verbosity = VERBOSITY_SILENT;
+        else if (strcmp(argv[a], "-s") == 0) verbosity = VERBOSITY_SUMMARY;
+        else if (strcmp(argv[a], "-v") == 0) verbosity = VERBOSITY_FULL;
+        else if (strcmp(argv[a], "-e") == 0 && a + 1 < argc) {
+            a++;
+            if (strcmp(argv[a], "select") == 0) engine = ENGINE_SELECT;
+            else if (strcmp(argv[a], "heap") == 0) engine = ENGINE_HEAP;
+            else if (strcmp(argv[a], "soa") == 0) engine = ENGINE_SOA;
+            else engine = ENGINE_SORT;
+        }
+    }
+    // Prompts must appear immediately when typing; otherwise write in large blocks
+    if (!isatty(STDIN_FILENO)) {
+        setvbuf(stdout, NULL, _IOFBF, OUTPUT_BUFFER_SIZE);
+    }
+}
 
 // --- 1. Define the Item Structure ---
 typedef struct {
     float profit;
     float weight;
     float ratio; // Profit-to-Weight ratio (p/w)
+    int id;      // Input order (Item 1, Item 2, ...), kept through reordering
 } Item;
 
 // --- 2. Comparison Function for Sorting  ---
@@ -26,36 +97,38 @@ int compareItems(const void *a, const void *b) {
 
 
 // --- 3. The Main Fractional Knapsack Logic ---
-float fractionalKnapsack(float W, Item items[], int n) {
+// Items with weight <= 0 always fit, so they rank first in every engine
+static inline float itemRatio(float profit, float weight) {
+    return (weight > 0) ? profit / weight : INFINITY;
+}
+
+// Fills in every item's ratio and clears fractions[]
+static void computeRatios(Item items[], int n, float fractions[]) {
+    for (int i = 0; i < n; i++) {
+        items[i].ratio = itemRatio(items[i].profit, items[i].weight);
+        fractions[i] = 0.0;
+    }
+}
+
+/*
+ * Sorts items by ratio (highest first) and writes how much of each sorted
+ * item is taken into fractions[i] (0 = skipped, 1 = whole). 'fractions'
+ * must have room for n entries. Returns the maximum profit.
+ */
+float fractionalKnapsack(float W, Item items[], int n, float fractions[]) {
     
     float maxProfit = 0.0;
     
     float currentCapacity = W;
 
-    
-    for (int i = 0; i < n; i++) {
-    
-        if (items[i].weight > 0) {
-            items[i].ratio = items[i].profit / items[i].weight;
-        } else {
-            items[i].ratio = 0.0; 
-        }
-    }
-
+    computeRatios(items, n, fractions);
     
     qsort(items, n, sizeof(Item), compareItems);
-
-    printf("\n--- Selection Order (Highest Ratio First) ---\n");
-    for(int i = 0; i < n; i++) {
-        printf("Item %d: P=%.2f, W=%.2f, Ratio=%.2f\n", i + 1, items[i].profit, items[i].weight, items[i].ratio);
-    }
-    printf("--------------------------------------------\n");
-
-
     
     for (int i = 0; i < n; i++) {
         
-        if (currentCapacity <= 0) {
+        // Zero-weight items rank first and are taken even when W is 0
+        if (currentCapacity <= 0 && items[i].weight > 0) {
             break;
         }
 
@@ -64,21 +137,15 @@ float fractionalKnapsack(float W, Item items[], int n) {
             
             currentCapacity -= items[i].weight;
             maxProfit += items[i].profit;
-            printf("TAKE WHOLE Item %d (P: %.2f, W: %.2f). Remaining Capacity: %.2f\n",
-                   i + 1, items[i].profit, items[i].weight, currentCapacity);
+            fractions[i] = 1.0;
         }
         
         else {
             
             float fraction = currentCapacity / items[i].weight;
-            float profitToAdd = items[i].profit * fraction;
-
-            maxProfit += profitToAdd;
+            maxProfit += items[i].profit * fraction;
+            fractions[i] = fraction;
             currentCapacity = 0; 
-
-            printf("TAKE FRACTIONAL Item %d (Fraction: %.2f, Profit Added: %.2f). Knapsack is full.\n",
-                   i + 1, fraction, profitToAdd);
-            
             
             break;
         }
@@ -87,22 +154,485 @@ float fractionalKnapsack(float W, Item items[], int n) {
     return maxProfit;
 }
 
+// --- 3b. Linear-Time Engine (Weighted-Median Selection) ---
+
+static inline void swapItems(Item items[], int a, int b) {
+    Item tmp = items[a];
+    items[a] = items[b];
+    items[b] = tmp;
+}
+
+/*
+ * Finds the critical ratio without sorting. Each round picks a random
+ * pivot ratio and partitions the active range into > pivot | == pivot |
+ * < pivot. If the items above the pivot already overflow the knapsack,
+ * only that part is searched further; otherwise they are all taken, the
+ * equal ones are taken in turn, and the search continues below the pivot.
+ * Every round discards one side, so the expected total work is O(n).
+ * Taken items end up in descending ratio blocks in front of the others.
+ */
+float fractionalKnapsackSelect(float W, Item items[], int n, float fractions[]) {
+    float maxProfit = 0.0;
+    float currentCapacity = W;
+    int lo = 0, hi = n;
+
+    computeRatios(items, n, fractions);
+
+    // Zero-weight items (ratio +infinity) form the first block, even when W is 0
+    for (int i = 0; i < hi; i++) {
+        if (items[i].weight <= 0) {
+            swapItems(items, i, lo);
+            currentCapacity -= items[lo].weight;
+            maxProfit += items[lo].profit;
+            fractions[lo++] = 1.0;
+        }
+    }
+
+    while (lo < hi && currentCapacity > 0) {
+        float pivot = items[lo + rand() % (hi - lo)].ratio;
+
+        // Three-way partition of [lo, hi): [lo, gt) > pivot, [gt, lt) == pivot, [lt, hi) < pivot
+        int gt = lo, i = lo, lt = hi;
+        while (i < lt) {
+            if (items[i].ratio > pivot) {
+                swapItems(items, i++, gt++);
+            } else if (items[i].ratio < pivot) {
+                swapItems(items, i, --lt);
+            } else {
+                i++;
+            }
+        }
+
+        float greaterWeight = 0.0;
+        for (int k = lo; k < gt; k++) {
+            greaterWeight += items[k].weight;
+        }
+        if (greaterWeight > currentCapacity) {
+            hi = gt; // The critical item is above the pivot
+            continue;
+        }
+
+        // Everything above the pivot fits
+        for (int k = lo; k < gt; k++) {
+            currentCapacity -= items[k].weight;
+            maxProfit += items[k].profit;
+            fractions[k] = 1.0;
+        }
+
+        // Items at the pivot ratio, in turn, as the sorted scan would
+        for (int k = gt; k < lt && currentCapacity > 0; k++) {
+            if (items[k].weight <= currentCapacity) {
+                currentCapacity -= items[k].weight;
+                maxProfit += items[k].profit;
+                fractions[k] = 1.0;
+            } else {
+                fractions[k] = currentCapacity / items[k].weight;
+                maxProfit += items[k].profit * fractions[k];
+                currentCapacity = 0;
+            }
+        }
+        lo = lt;
+    }
+
+    return maxProfit;
+}
+
+// --- 3c. Partial-Sort Engine (Heap) ---
+
+static void siftDownByRatio(Item items[], int size, int i) {
+    for (;;) {
+        int largest = i;
+        int left = 2 * i + 1, right = 2 * i + 2;
+        if (left < size && items[left].ratio > items[largest].ratio) largest = left;
+        if (right < size && items[right].ratio > items[largest].ratio) largest = right;
+        if (largest == i) break;
+        swapItems(items, i, largest);
+        i = largest;
+    }
+}
+
+/*
+ * Builds a max-heap on ratio in O(n), then pops items only until the
+ * knapsack is full. Popped items are moved behind the heap; at the end
+ * they are reversed so the taken items read in descending ratio order.
+ */
+float fractionalKnapsackHeap(float W, Item items[], int n, float fractions[]) {
+    float maxProfit = 0.0;
+    float currentCapacity = W;
+    int size = n;
+
+    computeRatios(items, n, fractions);
+    for (int i = n / 2 - 1; i >= 0; i--) {
+        siftDownByRatio(items, n, i);
+    }
+
+    // Zero-weight items sit on top of the heap and are taken even when W is 0
+    while (size > 0 && (currentCapacity > 0 || items[0].weight <= 0)) {
+        swapItems(items, 0, --size);
+        siftDownByRatio(items, size, 0);
+
+        if (items[size].weight <= currentCapacity) {
+            currentCapacity -= items[size].weight;
+            maxProfit += items[size].profit;
+            fractions[size] = 1.0;
+        } else {
+            fractions[size] = currentCapacity / items[size].weight;
+            maxProfit += items[size].profit * fractions[size];
+            currentCapacity = 0;
+        }
+    }
+
+    // Reverse the popped tail into descending ratio order
+    for (int a = size, b = n - 1; a < b; a++, b--) {
+        swapItems(items, a, b);
+        float f = fractions[a];
+        fractions[a] = fractions[b];
+        fractions[b] = f;
+    }
+
+    return maxProfit;
+}
+
+// --- 3d. Structure-of-Arrays Engine ---
+/*
+ * Profits, weights and ratios live in separate heap-allocated,
+ * SOA_ALIGNMENT-aligned double columns, so the ratio pass streams two
+ * arrays and writes a third with no gaps. Sorting moves 16-byte
+ * (ratio, index) keys instead of whole items.
+ */
+typedef struct {
+    int n;
+    double *profit;
+    double *weight;
+    double *ratio;
+} ItemStore;
+
+typedef struct {
+    double ratio;
+    int index;
+} RatioKey;
+
+static double *allocColumn(int n) {
+    // aligned_alloc needs a size that is a multiple of the alignment
+    size_t bytes = ((size_t)n * sizeof(double) + SOA_ALIGNMENT - 1) / SOA_ALIGNMENT * SOA_ALIGNMENT;
+    return (double *)aligned_alloc(SOA_ALIGNMENT, bytes ? bytes : SOA_ALIGNMENT);
+}
+
+void freeItemStore(ItemStore *store) {
+    if (store == NULL) return;
+    free(store->profit);
+    free(store->weight);
+    free(store->ratio);
+    free(store);
+}
+
+ItemStore *createItemStore(const Item items[], int n) {
+    ItemStore *store = (ItemStore *)calloc(1, sizeof(ItemStore));
+    if (store == NULL) {
+        return NULL;
+    }
+    store->n = n;
+    store->profit = allocColumn(n);
+    store->weight = allocColumn(n);
+    store->ratio = allocColumn(n);
+    if (store->profit == NULL || store->weight == NULL || store->ratio == NULL) {
+        freeItemStore(store);
+        return NULL;
+    }
+    for (int i = 0; i < n; i++) {
+        store->profit[i] = items[i].profit;
+        store->weight[i] = items[i].weight;
+    }
+    return store;
+}
+
+/*
+ * ratio = profit / weight, or +infinity when weight <= 0 (as itemRatio),
+ * without a branch: non-positive weights divide by 1 and the result is
+ * blended to infinity. Four lanes at a time with AVX; the scalar loop
+ * finishes the tail (or does all of it without AVX) with the same
+ * selects done on the bit patterns.
+ */
+void computeRatiosSoA(ItemStore *store) {
+    int i = 0;
+#ifdef __AVX__
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d one = _mm256_set1_pd(1.0);
+    const __m256d inf = _mm256_set1_pd(HUGE_VAL);
+    for (; i + 4 <= store->n; i += 4) {
+        __m256d p = _mm256_load_pd(&store->profit[i]);
+        __m256d w = _mm256_load_pd(&store->weight[i]);
+        __m256d positive = _mm256_cmp_pd(w, zero, _CMP_GT_OQ);
+        __m256d safeW = _mm256_blendv_pd(one, w, positive);
+        _mm256_store_pd(&store->ratio[i], _mm256_blendv_pd(inf, _mm256_div_pd(p, safeW), positive));
+    }
+#endif
+    const uint64_t oneBits = 0x3FF0000000000000ULL, infBits = 0x7FF0000000000000ULL; // 1.0 and +infinity
+    for (; i < store->n; i++) {
+        uint64_t bits, positive = -(uint64_t)(store->weight[i] > 0); // All ones or zeros, as the AVX compare
+        double safeW, ratio;
+        memcpy(&bits, &store->weight[i], sizeof bits);
+        bits = (bits & positive) | (oneBits & ~positive);
+        memcpy(&safeW, &bits, sizeof bits);
+        ratio = store->profit[i] / safeW;
+        memcpy(&bits, &ratio, sizeof bits);
+        bits = (bits & positive) | (infBits & ~positive);
+        memcpy(&store->ratio[i], &bits, sizeof bits);
+    }
+}
+
+int compareRatioKeys(const void *a, const void *b) {
+    double ra = ((const RatioKey *)a)->ratio;
+    double rb = ((const RatioKey *)b)->ratio;
+    return (ra < rb) - (ra > rb); // Descending
+}
+
+/*
+ * Sort-based greedy over the store. order[r] is the item index taken at
+ * rank r and fractions[r] how much of it; the maximum profit goes to
+ * *result. Returns 0 if the key array could not be allocated.
+ */
+int fractionalKnapsackSoA(double W, ItemStore *store, int order[], float fractions[], double *result) {
+    int n = store->n;
+    RatioKey *keys = (RatioKey *)malloc((size_t)n * sizeof(RatioKey));
+    if (keys == NULL) {
+        return 0;
+    }
+
+    computeRatiosSoA(store);
+    for (int i = 0; i < n; i++) {
+        keys[i].ratio = store->ratio[i];
+        keys[i].index = i;
+    }
+    qsort(keys, n, sizeof(RatioKey), compareRatioKeys);
+
+    double maxProfit = 0.0;
+    double currentCapacity = W;
+    for (int r = 0; r < n; r++) {
+        int i = keys[r].index;
+        order[r] = i;
+        fractions[r] = 0.0f;
+        if (currentCapacity <= 0 && store->weight[i] > 0) {
+            continue; // Zero-weight items rank first and are taken even when W is 0
+        }
+        if (store->weight[i] <= currentCapacity) {
+            currentCapacity -= store->weight[i];
+            maxProfit += store->profit[i];
+            fractions[r] = 1.0f;
+        } else {
+            double fraction = currentCapacity / store->weight[i];
+            maxProfit += store->profit[i] * fraction;
+            fractions[r] = (float)fraction;
+            currentCapacity = 0;
+        }
+    }
+
+    free(keys);
+    *result = maxProfit;
+    return 1;
+}
+
+// Runs the SoA engine on an Item array and leaves the items in rank order for reporting
+static float solveWithItemStore(float W, Item items[], int n, float fractions[]) {
+    ItemStore *store = createItemStore(items, n);
+    int *order = (int *)malloc(n * sizeof(int));
+    Item *ranked = (Item *)malloc(n * sizeof(Item));
+    double profit = 0.0;
+
+    if (store == NULL || order == NULL || ranked == NULL ||
+        !fractionalKnapsackSoA(W, store, order, fractions, &profit)) {
+        // Out of memory: the AoS sort engine needs no extra buffers
+        freeItemStore(store);
+        free(order);
+        free(ranked);
+        return fractionalKnapsack(W, items, n, fractions);
+    }
+
+    for (int r = 0; r < n; r++) {
+        ranked[r] = items[order[r]];
+        ranked[r].ratio = (float)store->ratio[order[r]];
+    }
+    memcpy(items, ranked, n * sizeof(Item));
+
+    freeItemStore(store);
+    free(order);
+    free(ranked);
+    return (float)profit;
+}
+
+float solveKnapsack(KnapsackEngine which, float W, Item items[], int n, float fractions[]) {
+    switch (which) {
+        case ENGINE_SELECT: return fractionalKnapsackSelect(W, items, n, fractions);
+        case ENGINE_HEAP:   return fractionalKnapsackHeap(W, items, n, fractions);
+        case ENGINE_SOA:    return solveWithItemStore(W, items, n, fractions);
+        default:            return fractionalKnapsack(W, items, n, fractions);
+    }
+}
+
+// --- 3e. Multi-Query Engine (Prefix Sums + Binary Search) ---
+/*
+ * For many capacities against the same catalog: sort once by ratio and
+ * keep prefix sums of weight and profit (in double, so long sums do not
+ * drift). A query for capacity W takes every item up to the last prefix
+ * that fits, found by binary search, plus a fraction of the next item:
+ * O(log n) per query instead of a re-sort.
+ */
+typedef struct {
+    int n;
+    Item *items;          // Sorted by ratio, highest first
+    double *prefixWeight; // prefixWeight[k] = total weight of items[0..k-1]
+    double *prefixProfit;
+} KnapsackIndex;
+
+KnapsackIndex *buildKnapsackIndex(const Item catalog[], int n) {
+    KnapsackIndex *index = (KnapsackIndex *)malloc(sizeof(KnapsackIndex));
+    if (index == NULL) {
+        return NULL;
+    }
+    index->n = n;
+    index->items = (Item *)malloc(n * sizeof(Item));
+    index->prefixWeight = (double *)malloc((n + 1) * sizeof(double));
+    index->prefixProfit = (double *)malloc((n + 1) * sizeof(double));
+    if (index->items == NULL || index->prefixWeight == NULL || index->prefixProfit == NULL) {
+        free(index->items);
+        free(index->prefixWeight);
+        free(index->prefixProfit);
+        free(index);
+        return NULL;
+    }
+
+    memcpy(index->items, catalog, n * sizeof(Item));
+    for (int i = 0; i < n; i++) {
+        Item *item = &index->items[i];
+        item->ratio = itemRatio(item->profit, item->weight);
+    }
+    qsort(index->items, n, sizeof(Item), compareItems);
+
+    index->prefixWeight[0] = 0.0;
+    index->prefixProfit[0] = 0.0;
+    for (int i = 0; i < n; i++) {
+        index->prefixWeight[i + 1] = index->prefixWeight[i] + index->items[i].weight;
+        index->prefixProfit[i + 1] = index->prefixProfit[i] + index->items[i].profit;
+    }
+    return index;
+}
+
+void freeKnapsackIndex(KnapsackIndex *index) {
+    if (index == NULL) return;
+    free(index->items);
+    free(index->prefixWeight);
+    free(index->prefixProfit);
+    free(index);
+}
+
+float queryKnapsack(const KnapsackIndex *index, float W) {
+    // Largest k with prefixWeight[k] <= W: items[0..k-1] are taken whole
+    int lo = 0, hi = index->n;
+    while (lo < hi) {
+        int mid = lo + (hi - lo + 1) / 2;
+        if (index->prefixWeight[mid] <= W) {
+            lo = mid;
+        } else {
+            hi = mid - 1;
+        }
+    }
+
+    double profit = index->prefixProfit[lo];
+    if (lo < index->n) {
+        const Item *next = &index->items[lo];
+        profit += next->profit * ((W - index->prefixWeight[lo]) / next->weight);
+    }
+    return (float)profit;
+}
+
+typedef struct {
+    const KnapsackIndex *index;
+    const float *capacities;
+    float *profits;
+    int begin;
+    int end;
+} QueryTask;
+
+static void *queryWorker(void *arg) {
+    QueryTask *task = (QueryTask *)arg;
+    for (int q = task->begin; q < task->end; q++) {
+        task->profits[q] = queryKnapsack(task->index, task->capacities[q]);
+    }
+    return NULL;
+}
+
+// Answers profits[q] for every capacities[q], split across threads for large batches
+void queryKnapsackBatch(const KnapsackIndex *index, const float capacities[], float profits[], int count) {
+    int threads = (count >= QUERY_PARALLEL_MIN) ? QUERY_THREADS : 1;
+    pthread_t tids[QUERY_THREADS];
+    QueryTask tasks[QUERY_THREADS];
+    int started[QUERY_THREADS] = {0};
+
+    for (int t = 0; t < threads; t++) {
+        tasks[t] = (QueryTask){ index, capacities, profits,
+                                (int)((long long)count * t / threads),
+                                (int)((long long)count * (t + 1) / threads) };
+        if (threads > 1) {
+            started[t] = (pthread_create(&tids[t], NULL, queryWorker, &tasks[t]) == 0);
+        }
+        if (!started[t]) {
+            queryWorker(&tasks[t]);
+        }
+    }
+    for (int t = 0; t < threads; t++) {
+        if (started[t]) {
+            pthread_join(tids[t], NULL);
+        }
+    }
+}
+
+// Prints the selection order (sorting engines only) and every take step from the fractions buffer
+void reportKnapsack(float W, const Item items[], int n, const float fractions[]) {
+    if (verbosity < VERBOSITY_FULL) {
+        return;
+    }
+
+    if (engine == ENGINE_SORT || engine == ENGINE_SOA) {
+        printf("\n--- Selection Order (Highest Ratio First) ---\n");
+        for(int i = 0; i < n; i++) {
+            printf("Item %d: P=%.2f, W=%.2f, Ratio=%.2f\n", items[i].id, items[i].profit, items[i].weight, items[i].ratio);
+        }
+    }
+    printf("--------------------------------------------\n");
+
+    // Replays the take steps in output order; only the fractional item, if any, comes last
+    float currentCapacity = W;
+    for (int i = 0; i < n; i++) {
+        if (fractions[i] == 1.0f) {
+            currentCapacity -= items[i].weight;
+            printf("TAKE WHOLE Item %d (P: %.2f, W: %.2f). Remaining Capacity: %.2f\n",
+                   items[i].id, items[i].profit, items[i].weight, currentCapacity);
+        } else if (fractions[i] > 0.0f) {
+            printf("TAKE FRACTIONAL Item %d (Fraction: %.2f, Profit Added: %.2f). Knapsack is full.\n",
+                   items[i].id, fractions[i], items[i].profit * fractions[i]);
+        }
+    }
+}
+
 // --- 4. Main Function  ---
-int main() {
+int main(int argc, char *argv[]) {
     int n = 0; 
     float capacity = 0.0; 
     Item *items = NULL;
+    float *fractions = NULL;
     float result = 0.0;
 
+    parseOptions(argc, argv);
+
     // 1. Get Knapsack Capacity
-    printf("Enter the total Knapsack Capacity (W): ");
+    REPORT(VERBOSITY_FULL, "Enter the total Knapsack Capacity (W): ");
     if (scanf("%f", &capacity) != 1 || capacity < 0) {
         printf("Invalid capacity input. Exiting.\n");
         return 1;
     }
 
     // 2. Get Number of Items
-    printf("Enter the number of items (n): ");
+    REPORT(VERBOSITY_FULL, "Enter the number of items (n): ");
     if (scanf("%d", &n) != 1 || n <= 0) {
         printf("Invalid number of items. Exiting.\n");
         return 1;
@@ -110,48 +640,94 @@ int main() {
     
     // 3. Dynamically Allocate Memory for Items
     items = (Item *)malloc(n * sizeof(Item));
-    if (items == NULL) {
+    fractions = (float *)malloc(n * sizeof(float));
+    if (items == NULL || fractions == NULL) {
         printf("Memory allocation failed. Exiting.\n");
+        free(items);
+        free(fractions);
         return 1;
     }
 
     // 4. Get Profit and Weight for Each Item
-    printf("\n--- Enter Item Details ---\n");
+    REPORT(VERBOSITY_FULL, "\n--- Enter Item Details ---\n");
     for (int i = 0; i < n; i++) {
-        printf("Item %d:\n", i + 1);
-        printf("  Enter Profit (P): ");
+        REPORT(VERBOSITY_FULL, "Item %d:\n", i + 1);
+        REPORT(VERBOSITY_FULL, "  Enter Profit (P): ");
         if (scanf("%f", &items[i].profit) != 1) {
              printf("Invalid profit input. Exiting.\n");
              free(items);
+             free(fractions);
              return 1;
         }
         
-        printf("  Enter Weight (W): ");
+        REPORT(VERBOSITY_FULL, "  Enter Weight (W): ");
         if (scanf("%f", &items[i].weight) != 1) {
              printf("Invalid weight input. Exiting.\n");
              free(items);
+             free(fractions);
              return 1;
         }
         // Initialize ratio to 0.0
         items[i].ratio = 0.0;
+        items[i].id = i + 1;
     }
-    printf("--------------------------\n");
+    REPORT(VERBOSITY_FULL, "--------------------------\n");
 
     // Display collected inputs
-    printf("\nKnapsack Capacity (W): %.2f\n", capacity);
-    printf("Items to consider:\n");
-    for(int i = 0; i < n; i++) {
+    REPORT(VERBOSITY_SUMMARY, "\nKnapsack Capacity (W): %.2f\n", capacity);
+    REPORT(VERBOSITY_FULL, "Items to consider:\n");
+    for(int i = 0; verbosity == VERBOSITY_FULL && i < n; i++) {
         printf("- Item %d: Profit=%.2f, Weight=%.2f\n", i + 1, items[i].profit, items[i].weight);
     }
     
     // 5. Call the function to find the maximum profit
-    result = fractionalKnapsack(capacity, items, n);
+    result = solveKnapsack(engine, capacity, items, n, fractions);
+    reportKnapsack(capacity, items, n, fractions);
 
     // 6. Display the final result
-    printf("\n\n*** Maximum Profit Achieved: %.2f ***\n", result);
+    REPORT(VERBOSITY_SUMMARY, "\n\n*** Maximum Profit Achieved: %.2f ***\n", result);
+
+    // 7. Further capacities against the same items, answered from a one-time index
+    int queries = 0;
+    REPORT(VERBOSITY_FULL, "\nEnter the number of additional capacities to query (0 to skip): ");
+    if (scanf("%d", &queries) == 1 && queries > 0) {
+        KnapsackIndex *index = buildKnapsackIndex(items, n);
+        float *capacities = (float *)malloc(queries * sizeof(float));
+        float *profits = (float *)malloc(queries * sizeof(float));
+        if (index == NULL || capacities == NULL || profits == NULL) {
+            printf("Memory allocation failed. Exiting.\n");
+            freeKnapsackIndex(index);
+            free(capacities);
+            free(profits);
+            free(items);
+            free(fractions);
+            return 1;
+        }
+
+        int valid = 1;
+        for (int q = 0; q < queries && valid; q++) {
+            REPORT(VERBOSITY_FULL, "  Capacity %d: ", q + 1);
+            valid = (scanf("%f", &capacities[q]) == 1 && capacities[q] >= 0);
+        }
+        if (valid) {
+            queryKnapsackBatch(index, capacities, profits, queries);
+            REPORT(VERBOSITY_SUMMARY, "\n--- Capacity Queries ---\n");
+            for (int q = 0; verbosity == VERBOSITY_FULL && q < queries; q++) {
+                printf("W = %.2f -> Maximum Profit: %.2f\n", capacities[q], profits[q]);
+            }
+            REPORT(VERBOSITY_SUMMARY, "Answered %d queries.\n", queries);
+        } else {
+            printf("Invalid capacity input. Skipping queries.\n");
+        }
+
+        freeKnapsackIndex(index);
+        free(capacities);
+        free(profits);
+    }
 
-    // 7. Free the allocated memory
+    // 8. Free the allocated memory
     free(items);
+    free(fractions);
 
     return 0;
 }
@@ -1,24 +1,94 @@
+#define _POSIX_C_SOURCE 200809L // isatty, sysconf
 #include <stdio.h> 
 #include <stdlib.h> 
 #include <string.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <math.h>
+#include <unistd.h>
+#include <pthread.h>
 
 // Define the maximum size for our alphabet (256 standard ASCII characters)
 #define MAX_ALPHABET_SIZE 256
 // Define the maximum length for the input string.
 #define MAX_INPUT_LENGTH 1000
+// stdout buffer used when input is not typed at a terminal
+#define OUTPUT_BUFFER_SIZE (1 << 20)
+// Bits resolved per decode-table lookup; longer codes continue in secondary tables
+#define DECODE_TABLE_BITS 10
+// Longest code the 64-bit bit reader can always peek in one refill
+#define MAX_CODE_BITS 56
+// File mode codes the input in independent blocks of this size
+#define CODEC_BLOCK_SIZE (1 << 20)
+// Most worker threads the file codec starts (build with -pthread); it uses one per core
+#define CODEC_MAX_THREADS 32
+// Default code length limit; -l picks another between MIN_CODE_LIMIT and MAX_CODE_BITS
+#define DEFAULT_CODE_LIMIT 15
+// Smallest limit that still fits a code for each of the 256 byte values
+#define MIN_CODE_LIMIT 8
+// Interleaved sub-tables of the byte histogram, and the most bytes counted before they are merged
+#define HISTOGRAM_TABLES 4
+#define HISTOGRAM_RUN (1u << 30)
+// Blocks with more entropy (bits per byte) than this are stored without building codes
+#define STORE_ENTROPY_BITS 7.95
+// Bitstreams per block in the interleaved (-m) container
+#define INTERLEAVED_STREAMS 4
+
+// --- 0. Output Verbosity ---
+/*
+ * The Huffman steps never print; codes and decoded text go into caller
+ * buffers and main reports them. Chosen on the command line:
+ *   -q  silent  (errors only)
+ *   -s  summary (total bits)
+ *   -v  full    (frequencies, codes and both strings, the default)
+ * "-c <in> <out>" compresses a file and "-d <in> <out>" restores it.
+ * "-l <bits>" caps the code length (DEFAULT_CODE_LIMIT by default).
+ * "-e <file>" only reports the byte entropy of a file.
+ * "-m" with -c writes INTERLEAVED_STREAMS bitstreams per block.
+ */
+typedef enum {
+    VERBOSITY_SILENT,
+    VERBOSITY_SUMMARY,
+    VERBOSITY_FULL
+} Verbosity;
+
+static Verbosity verbosity = VERBOSITY_FULL;
+static int codeLimit = DEFAULT_CODE_LIMIT;
+static int codecStreams = 1;
+
+#define REPORT(level, ...) do { if (verbosity >= (level)) printf(__VA_ARGS__); } while (0)
+
+static void parseOptions(int argc, char *argv[]) {
+    for (int a = 1; a < argc; a++) {
+        if (strcmp(argv[a], "-q") == 0) verbosity = VERBOSITY_SILENT;
+        else if (strcmp(argv[a], "-s") == 0) verbosity = VERBOSITY_SUMMARY;
+        else if (strcmp(argv[a], "-v") == 0) verbosity = VERBOSITY_FULL;
+        else if (strcmp(argv[a], "-m") == 0) codecStreams = INTERLEAVED_STREAMS;
+        else if (strcmp(argv[a], "-l") == 0 && a + 1 < argc) {
+            int limit = atoi(argv[++a]);
+            if (limit < MIN_CODE_LIMIT || limit > MAX_CODE_BITS) {
+                printf("Warning: code limit must be %d..%d; using %d.\n", MIN_CODE_LIMIT, MAX_CODE_BITS, DEFAULT_CODE_LIMIT);
+            } else {
+                codeLimit = limit;
+            }
+        }
+    }
+    // Prompts must appear immediately when typing; otherwise write in large blocks
+    if (!isatty(STDIN_FILENO)) {
+        setvbuf(stdout, NULL, _IOFBF, OUTPUT_BUFFER_SIZE);
+    }
+}
 
 // --- 1. Define the Node Structure --
 typedef struct Node {
     char data;          
-    int freq;           
+    uint64_t freq;      // 64-bit so counts over multi-GB inputs do not overflow
     struct Node *left; 
     struct Node *right;
 } Node;
 
-char codeTable[MAX_ALPHABET_SIZE][MAX_ALPHABET_SIZE];
-
 // --- 2. Node Creation ---
-Node* createNode(char data, int freq) {
+Node* createNode(char data, uint64_t freq) {
     Node* newNode = (Node*)malloc(sizeof(Node));
     if (newNode == NULL) {
         perror("Memory allocation failed");
@@ -32,74 +102,609 @@ Node* createNode(char data, int freq) {
     return newNode;
 }
 
-// --- 3. Sorting Function (Simulates Min-Heap Extraction) ---
+// --- 3. Frequency Ordering ---
 // Used by qsort to sort nodes by frequency in ASCENDING order.
 int compareNodes(const void *a, const void *b) {
     // (pointers to Node pointers).
     const Node* nodeA = *(const Node**)a;
     const Node* nodeB = *(const Node**)b;
     
-    // Returns a negative number if nodeA is smaller, which sorts in ASCENDING order.
-    return (nodeA->freq - nodeB->freq);
+    // Compare rather than subtract: 64-bit differences do not fit in an int.
+    return (nodeA->freq > nodeB->freq) - (nodeA->freq < nodeB->freq);
+}
+
+// --- 3b. Byte Histogram ---
+/*
+ * Adds the byte counts of data[0..n) to counts[]. A run of equal bytes
+ * would make every increment wait for the previous one to the same
+ * counter, so the bytes of each 64-bit load are spread over
+ * HISTOGRAM_TABLES 32-bit sub-tables, merged every HISTOGRAM_RUN bytes.
+ */
+void countBytes(const uint8_t* data, size_t n, uint64_t counts[]) {
+    uint32_t sub[HISTOGRAM_TABLES][MAX_ALPHABET_SIZE];
+    while (n > 0) {
+        size_t run = n < HISTOGRAM_RUN ? n : HISTOGRAM_RUN;
+        size_t i = 0;
+        memset(sub, 0, sizeof sub);
+        for (; i + 8 <= run; i += 8) {
+            uint64_t word;
+            memcpy(&word, data + i, sizeof word);
+            sub[0][word & 0xff]++;
+            sub[1][(word >> 8) & 0xff]++;
+            sub[2][(word >> 16) & 0xff]++;
+            sub[3][(word >> 24) & 0xff]++;
+            sub[0][(word >> 32) & 0xff]++;
+            sub[1][(word >> 40) & 0xff]++;
+            sub[2][(word >> 48) & 0xff]++;
+            sub[3][word >> 56]++;
+        }
+        for (; i < run; i++) {
+            sub[0][data[i]]++;
+        }
+        for (int c = 0; c < MAX_ALPHABET_SIZE; c++) {
+            counts[c] += (uint64_t)sub[0][c] + sub[1][c] + sub[2][c] + sub[3][c];
+        }
+        data += run;
+        n -= run;
+    }
+}
+
+// Shannon entropy of a histogram in bits per byte: a lower bound on any byte-wise code.
+double entropyBitsPerByte(const uint64_t counts[]) {
+    uint64_t total = 0;
+    for (int c = 0; c < MAX_ALPHABET_SIZE; c++) total += counts[c];
+    if (total == 0) {
+        return 0.0;
+    }
+    double bits = 0.0;
+    for (int c = 0; c < MAX_ALPHABET_SIZE; c++) {
+        if (counts[c] > 0) {
+            double p = (double)counts[c] / (double)total;
+            bits -= p * log2(p);
+        }
+    }
+    return bits;
 }
 
 // --- 4. The Huffman Algorithm (Greedy Implementation) ---
-Node* buildHuffmanTree(Node** nodes, int n) {
-    int currentSize = n;
 
-    // The loop runs n-1 times to combine all 'n' initial nodes into one tree root.
-    for (int i = 0; i < n - 1; i++) {
-        
-        // 1. Sort (Simulate Extract-Min)
-        qsort(nodes, currentSize, sizeof(Node*), compareNodes);
+// Creates the parent of the two smallest nodes; its frequency is the sum of theirs.
+static Node* mergeNodes(Node* x, Node* y) {
+    Node* z = createNode('$', x->freq + y->freq); 
+    z->left = x;
+    z->right = y;
+    return z;
+}
 
-        // 2. Extract-Min: Pick the two smallest frequency nodes
-        Node* x = nodes[0]; // Smallest 
-        Node* y = nodes[1]; // Second smallest
+static void siftDownByFreq(Node** heap, int size, int i) {
+    Node* item = heap[i];
+    for (;;) {
+        int child = 2 * i + 1;
+        if (child >= size) break;
+        if (child + 1 < size && heap[child + 1]->freq < heap[child]->freq) child++;
+        if (heap[child]->freq >= item->freq) break;
+        heap[i] = heap[child];
+        i = child;
+    }
+    heap[i] = item;
+}
 
-        // 3. Create new internal node (z)
-        // Its frequency is the sum of its children's frequencies.
-        Node* z = createNode('$', x->freq + y->freq); 
-        
-        // Connect the two smallest nodes as its children
-        z->left = x;
-        z->right = y;
+static Node* heapPopMin(Node** heap, int* size) {
+    Node* top = heap[0];
+    heap[0] = heap[--(*size)];
+    siftDownByFreq(heap, *size, 0);
+    return top;
+}
 
-        // 4. Insert: Replace the two extracted nodes with the new parent node (z)
-        nodes[1] = z;
+static void heapPush(Node** heap, int* size, Node* node) {
+    int i = (*size)++;
+    while (i > 0 && heap[(i - 1) / 2]->freq > node->freq) {
+        heap[i] = heap[(i - 1) / 2];
+        i = (i - 1) / 2;
+    }
+    heap[i] = node;
+}
 
-        nodes[0] = nodes[currentSize - 1]; 
-        currentSize--; 
+// Binary min-heap builder, in place over 'nodes': O(n log n) for any leaf order.
+Node* buildHuffmanTreeHeap(Node** nodes, int n) {
+    int size = n;
+    for (int i = n / 2 - 1; i >= 0; i--) {
+        siftDownByFreq(nodes, size, i);
     }
 
-    // The final node remaining is the Root of the entire tree.
+    // The loop runs n-1 times to combine all 'n' initial nodes into one tree root.
+    while (size > 1) {
+        Node* x = heapPopMin(nodes, &size); // Smallest 
+        Node* y = heapPopMin(nodes, &size); // Second smallest
+        heapPush(nodes, &size, mergeNodes(x, y));
+    }
     return nodes[0];
 }
 
-// --- 5. Generate and Store Huffman Codes ---
-// Uses recursion to traverse the tree and record the binary code for each character.
-void generateCodes(Node* root, char code[], int top) {
-    // If we move left, add '0' to the code.
-    if (root->left) {
-        code[top] = '0';
-        generateCodes(root->left, code, top + 1);
+/*
+ * Two-queue builder for leaves already sorted by ascending frequency:
+ * merged nodes are created in non-decreasing frequency order, so they
+ * form a second sorted queue, and each step takes the smaller front of
+ * the two queues. O(n). Returns NULL if the queue cannot be allocated.
+ */
+Node* buildHuffmanTreeTwoQueue(Node** leaves, int n) {
+    Node** merged = (Node**)malloc((size_t)(n - 1) * sizeof(Node*));
+    if (merged == NULL) {
+        return NULL;
+    }
+
+    int leafHead = 0, mergedHead = 0, mergedTail = 0;
+    for (int step = 0; step < n - 1; step++) {
+        Node* pick[2];
+        for (int k = 0; k < 2; k++) {
+            // On equal frequencies prefer the leaf, which keeps codes shorter
+            if (mergedHead == mergedTail ||
+                (leafHead < n && leaves[leafHead]->freq <= merged[mergedHead]->freq)) {
+                pick[k] = leaves[leafHead++];
+            } else {
+                pick[k] = merged[mergedHead++];
+            }
+        }
+        merged[mergedTail++] = mergeNodes(pick[0], pick[1]);
+    }
+
+    Node* root = merged[mergedTail - 1];
+    free(merged);
+    return root;
+}
+
+// Uses the linear two-queue builder when the leaves are already sorted, the heap otherwise.
+Node* buildHuffmanTree(Node** nodes, int n) {
+    int sorted = 1;
+    for (int i = 1; i < n && sorted; i++) {
+        sorted = (nodes[i - 1]->freq <= nodes[i]->freq);
+    }
+    if (sorted) {
+        Node* root = buildHuffmanTreeTwoQueue(nodes, n);
+        if (root != NULL) {
+            return root;
+        }
+    }
+    return buildHuffmanTreeHeap(nodes, n);
+}
+
+// --- 5. Code Lengths and Canonical Codes ---
+// Records the depth of every leaf, which is the length of its code, and the deepest one.
+static void collectLengths(const Node* node, int depth, uint8_t lengths[], int* maxDepth) {
+    if (!node->left && !node->right) {
+        if (depth > *maxDepth) *maxDepth = depth;
+        lengths[(unsigned char)node->data] = (uint8_t)(depth > MAX_CODE_BITS ? 0 : depth);
+        return;
+    }
+    collectLengths(node->left, depth + 1, lengths, maxDepth);
+    collectLengths(node->right, depth + 1, lengths, maxDepth);
+}
+
+/*
+ * Package-merge: optimal code lengths with none longer than maxBits.
+ * Each level's list holds the leaves plus packages (pairs) from the
+ * level below, in weight order; a package remembers how often it
+ * contains each leaf. The cheapest 2n-2 items of the last list give
+ * every leaf's length as its number of appearances. O(n * maxBits)
+ * items. Returns 0 if n symbols do not fit in maxBits or memory runs out.
+ */
+int limitCodeLengths(const uint64_t counts[], uint8_t lengths[], int maxBits) {
+    uint8_t syms[MAX_ALPHABET_SIZE];
+    int n = 0;
+    for (int c = 0; c < MAX_ALPHABET_SIZE; c++) {
+        if (counts[c] > 0) syms[n++] = (uint8_t)c;
+    }
+    if (n < 2 || maxBits >= 64 || ((uint64_t)1 << maxBits) < (uint64_t)n) {
+        return 0;
+    }
+    // Leaves in ascending count order (insertion sort: at most 256 of them)
+    for (int i = 1; i < n; i++) {
+        uint8_t s = syms[i];
+        int j = i - 1;
+        while (j >= 0 && counts[syms[j]] > counts[s]) { syms[j + 1] = syms[j]; j--; }
+        syms[j + 1] = s;
+    }
+
+    // Two lists of up to 2n-1 items: weight plus a per-leaf appearance count
+    int maxItems = 2 * n - 1;
+    uint64_t* weight[2];
+    uint8_t* uses[2];
+    weight[0] = (uint64_t*)malloc((size_t)maxItems * sizeof(uint64_t));
+    weight[1] = (uint64_t*)malloc((size_t)maxItems * sizeof(uint64_t));
+    uses[0] = (uint8_t*)malloc((size_t)maxItems * n);
+    uses[1] = (uint8_t*)malloc((size_t)maxItems * n);
+    if (!weight[0] || !weight[1] || !uses[0] || !uses[1]) {
+        free(weight[0]); free(weight[1]); free(uses[0]); free(uses[1]);
+        return 0;
+    }
+
+    int cur = 0, size = n;
+    memset(uses[cur], 0, (size_t)n * n);
+    for (int i = 0; i < n; i++) {
+        weight[cur][i] = counts[syms[i]];
+        uses[cur][(size_t)i * n + i] = 1;
+    }
+    for (int level = 1; level < maxBits; level++) {
+        int nxt = 1 - cur, packages = size / 2, leaf = 0, pkg = 0, out = 0;
+        while (leaf < n || pkg < packages) {
+            uint8_t* row = &uses[nxt][(size_t)out * n];
+            // Leaves win ties, which keeps the lengths as even as possible
+            if (pkg >= packages || (leaf < n && counts[syms[leaf]] <= weight[cur][2 * pkg] + weight[cur][2 * pkg + 1])) {
+                memset(row, 0, (size_t)n);
+                row[leaf] = 1;
+                weight[nxt][out++] = counts[syms[leaf++]];
+            } else {
+                const uint8_t* a = &uses[cur][(size_t)(2 * pkg) * n];
+                const uint8_t* b = a + n;
+                for (int i = 0; i < n; i++) row[i] = (uint8_t)(a[i] + b[i]);
+                weight[nxt][out++] = weight[cur][2 * pkg] + weight[cur][2 * pkg + 1];
+                pkg++;
+            }
+        }
+        cur = nxt;
+        size = out;
+    }
+
+    memset(lengths, 0, MAX_ALPHABET_SIZE);
+    for (int item = 0; item < 2 * n - 2; item++) {
+        const uint8_t* row = &uses[cur][(size_t)item * n];
+        for (int i = 0; i < n; i++) lengths[syms[i]] = (uint8_t)(lengths[syms[i]] + row[i]);
+    }
+    free(weight[0]); free(weight[1]); free(uses[0]); free(uses[1]);
+    return 1;
+}
+
+/*
+ * Canonical codes: symbols ordered by (length, value) get consecutive
+ * codes, shifting left whenever the length grows. Returns 0 if the
+ * lengths over-subscribe the code space (not a valid prefix code).
+ */
+int assignCanonicalCodes(const uint8_t lengths[], uint64_t codes[]) {
+    uint64_t code = 0;
+    int previous = 0;
+    for (int len = 1; len <= MAX_CODE_BITS; len++) {
+        for (int c = 0; c < MAX_ALPHABET_SIZE; c++) {
+            if (lengths[c] != len) continue;
+            code <<= (len - previous);
+            previous = len;
+            if (code >> len) {
+                return 0;
+            }
+            codes[c] = code++;
+        }
     }
+    for (int c = 0; c < MAX_ALPHABET_SIZE; c++) {
+        if (lengths[c] > MAX_CODE_BITS) return 0;
+        if (lengths[c] == 0) codes[c] = 0;
+    }
+    return 1;
+}
 
-    // If we move right, add '1' to the code.
-    if (root->right) {
-        code[top] = '1';
-        generateCodes(root->right, code, top + 1);
+// Writes the low 'length' bits of 'code', most significant first.
+static void printCode(uint64_t code, int length) {
+    for (int b = length - 1; b >= 0; b--) {
+        putchar('0' + (int)((code >> b) & 1));
     }
+}
+
+// --- 5b. Bit Packing ---
 
-    // If it's a leaf node, we found a character and its full code.
-    if (!root->left && !root->right) {
-        code[top] = '\0'; // Null-terminate the string
+// MSB-first bit writer. Bits collect in a 64-bit buffer that is stored
+// as one whole word when full, so 'out' needs 8 bytes of slack past the
+// packed size.
+typedef struct {
+    uint8_t* out;
+    size_t pos;
+    uint64_t acc;  // Pending bits, left-aligned
+    int count;
+} BitWriter;
 
-        // Store the code in the global table, indexed by the ASCII value of the character.
-        strcpy(codeTable[(unsigned char)root->data], code); 
-        
-        printf("  '%c' (Freq: %d): %s\n", root->data, root->freq, code);
+static inline void emitWord(BitWriter* w, uint64_t word) {
+    for (int b = 0; b < 8; b++) {
+        w->out[w->pos + b] = (uint8_t)(word >> (56 - 8 * b)); // Big-endian: first bit first
     }
+    w->pos += 8;
+}
+
+// Appends the low 'length' (<= MAX_CODE_BITS) bits of 'code'
+static inline void writeBits(BitWriter* w, uint64_t code, int length) {
+    int room = 64 - w->count;
+    if (length < room) {
+        w->acc |= code << (room - length);
+        w->count += length;
+    } else {
+        // Fill the word, store it, and keep the rest of the code
+        emitWord(w, w->acc | (code >> (length - room)));
+        w->count = length - room;
+        w->acc = w->count ? code << (64 - w->count) : 0;
+    }
+}
+
+static void flushBits(BitWriter* w) {
+    for (int b = 0; b < w->count; b += 8) {
+        w->out[w->pos++] = (uint8_t)(w->acc >> (56 - b)); // Zero padding in the low bits
+    }
+    w->acc = 0;
+    w->count = 0;
+}
+
+// MSB-first bit reader over an in-memory stream. Bytes past the end read as zero.
+typedef struct {
+    const uint8_t* in;
+    size_t pos;
+    size_t size;
+    uint64_t acc;
+    int count;
+} BitReader;
+
+static inline void refillBits(BitReader* r) {
+    if (r->pos + 8 <= r->size) {
+        // Fast path: OR in a whole word. Bits past the whole bytes counted
+        // here are the same bytes the next refill loads again.
+        uint64_t word = 0;
+        for (int b = 0; b < 8; b++) {
+            word = (word << 8) | r->in[r->pos + b];
+        }
+        r->acc |= word >> r->count;
+        int bytes = (63 - r->count) >> 3;
+        r->pos += bytes;
+        r->count += bytes * 8;
+        return;
+    }
+    while (r->count <= 56) {
+        uint64_t byte = r->pos < r->size ? r->in[r->pos] : 0;
+        r->pos++;
+        r->acc |= byte << (56 - r->count);
+        r->count += 8;
+    }
+}
+
+static inline uint32_t peekBits(const BitReader* r, int n) {
+    return (uint32_t)(r->acc >> (64 - n));
+}
+
+static inline void skipBits(BitReader* r, int n) {
+    r->acc <<= n;
+    r->count -= n;
+}
+
+// --- 5c. Table-Driven Decoder ---
+/*
+ * Each lookup peeks 'bits' bits. A leaf entry names one or two symbols
+ * and how many bits they use; a link entry (count 0) points to a
+ * secondary table for codes longer than the current table resolves.
+ * The root table uses DECODE_TABLE_BITS, so short codes decode in one
+ * lookup and a pair of short codes often decodes in one lookup too.
+ */
+typedef struct {
+    uint32_t next;  // Link: index of the secondary table
+    uint8_t count;  // Symbols resolved (0 = link)
+    uint8_t bits;   // Leaf: bits consumed; link: index bits of the secondary table
+    uint8_t sym[2];
+} DecodeEntry;
+
+typedef struct {
+    DecodeEntry* entries; // Root table first, then all secondary tables
+    uint32_t size;
+    uint32_t capacity;
+    int lookupsPerRefill; // Lookups that never run past the bits one refill guarantees
+} HuffmanDecoder;
+
+static int reserveEntries(HuffmanDecoder* d, uint32_t count, uint32_t* start) {
+    if (d->size + count > d->capacity) {
+        uint32_t capacity = d->capacity ? d->capacity : 1024;
+        while (capacity < d->size + count) capacity *= 2;
+        DecodeEntry* grown = (DecodeEntry*)realloc(d->entries, capacity * sizeof(DecodeEntry));
+        if (grown == NULL) {
+            return 0;
+        }
+        d->entries = grown;
+        d->capacity = capacity;
+    }
+    *start = d->size;
+    memset(&d->entries[d->size], 0, count * sizeof(DecodeEntry));
+    d->size += count;
+    return 1;
+}
+
+/*
+ * Builds one table for symbols whose first 'consumed' bits were already
+ * used by the tables above it. Codes that fit fill every slot they
+ * prefix; longer ones are grouped by their next 'tableBits' bits and get
+ * a secondary table each. Returns the table's start index, or -1.
+ */
+static long buildDecodeTable(HuffmanDecoder* d, const uint8_t syms[], int n,
+                             const uint64_t codes[], const uint8_t lengths[],
+                             int consumed, int tableBits) {
+    uint32_t start;
+    if (!reserveEntries(d, (uint32_t)1 << tableBits, &start)) {
+        return -1;
+    }
+
+    char grouped[MAX_ALPHABET_SIZE] = {0};
+    for (int i = 0; i < n; i++) {
+        int s = syms[i];
+        int remaining = lengths[s] - consumed;
+        uint64_t rest = codes[s] & (((uint64_t)1 << remaining) - 1);
+
+        if (remaining <= tableBits) {
+            uint32_t first = (uint32_t)rest << (tableBits - remaining);
+            for (uint32_t k = 0; k < ((uint32_t)1 << (tableBits - remaining)); k++) {
+                DecodeEntry* e = &d->entries[start + first + k];
+                e->count = 1;
+                e->bits = (uint8_t)remaining;
+                e->sym[0] = (uint8_t)s;
+            }
+        } else if (!grouped[i]) {
+            // Gather every long code sharing this table slot
+            uint32_t key = (uint32_t)(rest >> (remaining - tableBits));
+            uint8_t group[MAX_ALPHABET_SIZE];
+            int groupSize = 0;
+            int longest = 0;
+            for (int j = i; j < n; j++) {
+                int r = lengths[syms[j]] - consumed;
+                if (!grouped[j] && r > tableBits &&
+                    (uint32_t)((codes[syms[j]] & (((uint64_t)1 << r) - 1)) >> (r - tableBits)) == key) {
+                    grouped[j] = 1;
+                    group[groupSize++] = syms[j];
+                    if (r - tableBits > longest) longest = r - tableBits;
+                }
+            }
+            int subBits = longest < DECODE_TABLE_BITS ? longest : DECODE_TABLE_BITS;
+            long sub = buildDecodeTable(d, group, groupSize, codes, lengths, consumed + tableBits, subBits);
+            if (sub < 0) {
+                return -1;
+            }
+            DecodeEntry* e = &d->entries[start + key]; // Re-fetch: the pool may have moved
+            e->count = 0;
+            e->bits = (uint8_t)subBits;
+            e->next = (uint32_t)sub;
+        }
+    }
+    return (long)start;
+}
+
+// Builds the decode tables from per-symbol (code, length); length 0 = unused symbol
+HuffmanDecoder* createDecoder(const uint64_t codes[], const uint8_t lengths[]) {
+    HuffmanDecoder* d = (HuffmanDecoder*)calloc(1, sizeof(HuffmanDecoder));
+    if (d == NULL) {
+        return NULL;
+    }
+    uint8_t syms[MAX_ALPHABET_SIZE];
+    int n = 0;
+    int longest = DECODE_TABLE_BITS; // A pair entry can use the whole root index
+    for (int c = 0; c < MAX_ALPHABET_SIZE; c++) {
+        if (lengths[c] > 0) syms[n++] = (uint8_t)c;
+        if (lengths[c] > longest) longest = lengths[c];
+    }
+    d->lookupsPerRefill = 56 / longest; // A refill leaves at least 56 bits
+    if (buildDecodeTable(d, syms, n, codes, lengths, 0, DECODE_TABLE_BITS) < 0) {
+        free(d->entries);
+        free(d);
+        return NULL;
+    }
+
+    // Pair up: if the bits left after a short root code hold a whole second
+    // short code, one lookup can emit both symbols.
+    // Pairs are looked up in a copy, so every entry pairs with single-symbol entries only.
+    const uint32_t mask = ((uint32_t)1 << DECODE_TABLE_BITS) - 1;
+    DecodeEntry* single = (DecodeEntry*)malloc((mask + 1) * sizeof(DecodeEntry));
+    if (single == NULL) {
+        return d; // Still a valid decoder, one symbol per lookup
+    }
+    memcpy(single, d->entries, (mask + 1) * sizeof(DecodeEntry));
+    for (uint32_t i = 0; i <= mask; i++) {
+        DecodeEntry* first = &d->entries[i];
+        if (first->count != 1) continue;
+        const DecodeEntry* second = &single[(i << first->bits) & mask];
+        if (second->count == 1 && first->bits + second->bits <= DECODE_TABLE_BITS) {
+            first->sym[1] = second->sym[0];
+            first->bits = (uint8_t)(first->bits + second->bits);
+            first->count = 2;
+        }
+    }
+    free(single);
+    return d;
+}
+
+void freeDecoder(HuffmanDecoder* d) {
+    if (d == NULL) return;
+    free(d->entries);
+    free(d);
+}
+
+/*
+ * Decodes the next one or two symbols into out (at most 'room') from the
+ * bits already buffered, which must cover the longest code.
+ * Returns how many were written, or 0 on an unused code (corrupt data).
+ * A paired entry always consumes both codes, so callers pass room < 2
+ * only for the very last symbol of a stream.
+ */
+static inline int decodeBuffered(const HuffmanDecoder* d, BitReader* r, uint8_t* out, size_t room) {
+    const DecodeEntry* e = &d->entries[peekBits(r, DECODE_TABLE_BITS)];
+    int tableBits = DECODE_TABLE_BITS;
+    while (e->count == 0) {
+        if (e->bits == 0) {
+            return 0; // Slot that no code reaches
+        }
+        // Long code: descend into the secondary table
+        skipBits(r, tableBits);
+        tableBits = e->bits;
+        e = &d->entries[e->next + peekBits(r, tableBits)];
+    }
+    skipBits(r, e->bits);
+    out[0] = e->sym[0];
+    if (e->count == 2 && room >= 2) {
+        out[1] = e->sym[1];
+        return 2;
+    }
+    return 1;
+}
+
+static inline int decodeNext(const HuffmanDecoder* d, BitReader* r, uint8_t* out, size_t room) {
+    refillBits(r);
+    return decodeBuffered(d, r, out, room);
+}
+
+static int decodeRun(const HuffmanDecoder* d, BitReader* r, uint8_t* out, size_t symbols) {
+    size_t produced = 0;
+    while (produced < symbols) {
+        int got = decodeNext(d, r, out + produced, symbols - produced);
+        if (got == 0) {
+            return 0;
+        }
+        produced += got;
+    }
+    return 1;
+}
+
+// Decodes 'symbols' symbols from a packed bitstream into 'out'. Returns 0 on corrupt data.
+int decodeWithTable(const HuffmanDecoder* d, const uint8_t* in, size_t size, size_t symbols, uint8_t* out) {
+    BitReader r = { in, 0, size, 0, 0 };
+    return decodeRun(d, &r, out, symbols);
+}
+
+/*
+ * Decodes INTERLEAVED_STREAMS independent bitstreams, stream s filling
+ * out[s] with symbols[s] symbols. Each step refills all four streams,
+ * then makes lookupsPerRefill lookups in each; their lookups do not
+ * depend on one another, so the CPU overlaps them instead of waiting on
+ * a single chain of shifts and loads.
+ */
+int decodeInterleaved(const HuffmanDecoder* d, BitReader r[], uint8_t* out[], const size_t symbols[]) {
+    size_t produced[INTERLEAVED_STREAMS] = {0};
+    const size_t stepRoom = 2 * (size_t)d->lookupsPerRefill;
+    // Lockstep while every stream still has room for a symbol pair per lookup
+    for (;;) {
+        int room = 1;
+        for (int s = 0; s < INTERLEAVED_STREAMS; s++) room &= (symbols[s] - produced[s] >= stepRoom);
+        if (!room) break;
+        refillBits(&r[0]);
+        refillBits(&r[1]);
+        refillBits(&r[2]);
+        refillBits(&r[3]);
+        int bad = 0;
+        for (int k = 0; k < d->lookupsPerRefill; k++) {
+            int g0 = decodeBuffered(d, &r[0], out[0] + produced[0], 2);
+            int g1 = decodeBuffered(d, &r[1], out[1] + produced[1], 2);
+            int g2 = decodeBuffered(d, &r[2], out[2] + produced[2], 2);
+            int g3 = decodeBuffered(d, &r[3], out[3] + produced[3], 2);
+            bad |= (g0 == 0) | (g1 == 0) | (g2 == 0) | (g3 == 0);
+            produced[0] += g0;
+            produced[1] += g1;
+            produced[2] += g2;
+            produced[3] += g3;
+        }
+        if (bad) {
+            return 0;
+        }
+    }
+    for (int s = 0; s < INTERLEAVED_STREAMS; s++) {
+        if (!decodeRun(d, &r[s], out[s] + produced[s], symbols[s] - produced[s])) {
+            return 0;
+        }
+    }
+    return 1;
 }
 
 // --- 6. Helper function for recursive tree cleanup (Good Practice) ---
@@ -110,15 +715,541 @@ void freeHuffmanTree(Node* root) {
     free(root);
 }
 
+// --- 6b. Code Lengths from Counts ---
+/*
+ * Huffman lengths for every byte value with a non-zero count, none
+ * longer than maxBits: the tree's own depths when they fit, otherwise
+ * package-merge lengths. Returns 0 on failure.
+ */
+int huffmanLengthsFromCounts(const uint64_t counts[], uint8_t lengths[], int maxBits) {
+    Node* nodes[MAX_ALPHABET_SIZE];
+    int n = 0;
+    memset(lengths, 0, MAX_ALPHABET_SIZE);
+    for (int c = 0; c < MAX_ALPHABET_SIZE; c++) {
+        if (counts[c] > 0) nodes[n++] = createNode((char)c, counts[c]);
+    }
+    if (n == 1) {
+        lengths[(unsigned char)nodes[0]->data] = 1; // A lone symbol still needs one bit
+        free(nodes[0]);
+        return 1;
+    }
+    if (n == 0) {
+        return 1;
+    }
+
+    Node* root = buildHuffmanTree(nodes, n);
+    int maxDepth = 0;
+    collectLengths(root, 0, lengths, &maxDepth);
+    freeHuffmanTree(root);
+    if (maxDepth > maxBits) {
+        return limitCodeLengths(counts, lengths, maxBits);
+    }
+    return 1;
+}
+
+
+// --- 7. Block-Parallel File Codec ---
+/*
+ * Container layout:
+ *   "HUF2"              4-byte magic
+ *   blocks, each:
+ *     raw size          4 bytes, little-endian (0 ends the container)
+ *     payload size      4 bytes, little-endian
+ *     code lengths      256 bytes, one per byte value (0 = unused)
+ *     payload           canonical codes, MSB-first, zero-padded to a byte
+ * "HUF4" containers (-m) split each block into INTERLEAVED_STREAMS
+ * contiguous segments, each coded as its own zero-padded bitstream. The
+ * payload then starts with a jump table: the byte sizes of all streams
+ * but the last, 4 bytes each, little-endian.
+ * Every block carries its own lengths, so blocks compress and decompress
+ * independently. All-zero lengths mark a stored block whose payload is
+ * the raw bytes, used when coding would not make the block smaller.
+ *
+ * The main thread reads blocks into a ring of slots and writes finished
+ * slots strictly in order; worker threads take filled slots in sequence
+ * and code them. The ring is the reorder buffer: a slot is reused only
+ * after it has been written.
+ */
+static const char HUFFMAN_MAGIC[4] = { 'H', 'U', 'F', '2' };
+static const char INTERLEAVED_MAGIC[4] = { 'H', 'U', 'F', '4' };
+
+#define BLOCK_HEADER_SIZE (4 + 4 + MAX_ALPHABET_SIZE)
+// Payload and output buffers: a whole block plus the bit writer's word of slack
+#define BLOCK_BUFFER_SIZE (CODEC_BLOCK_SIZE + 16)
+
+typedef enum {
+    SLOT_FREE,
+    SLOT_FILLED,
+    SLOT_DONE
+} SlotState;
+
+typedef struct {
+    uint8_t* in;          // Raw block (compress) or payload (decompress)
+    uint8_t* out;         // Header + payload (compress) or raw block (decompress)
+    size_t inSize;
+    size_t outSize;
+    uint8_t lengths[MAX_ALPHABET_SIZE]; // Decompress: lengths from the block header
+    SlotState state;
+    int failed;
+} CodecSlot;
+
+typedef struct {
+    CodecSlot* slots;
+    int slotCount;
+    int compress;
+    int streams;          // 1 or INTERLEAVED_STREAMS bitstreams per block
+    uint64_t filled;      // Blocks handed over by the reader
+    uint64_t claimed;     // Blocks taken by workers
+    int stop;
+    pthread_mutex_t lock;
+    pthread_cond_t work;  // A block was filled, or stop was set
+    pthread_cond_t done;  // A block finished
+} CodecPipeline;
+
+static void putLE32(uint8_t* p, uint32_t v) {
+    for (int b = 0; b < 4; b++) p[b] = (uint8_t)(v >> (8 * b));
+}
+
+static uint32_t getLE32(const uint8_t* p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+// Splits n symbols into 'streams' contiguous segments, all but the last of equal size.
+static void splitSegments(size_t n, int streams, size_t start[], size_t count[]) {
+    size_t segment = (n + streams - 1) / streams;
+    for (int s = 0; s < streams; s++) {
+        start[s] = (size_t)s * segment < n ? (size_t)s * segment : n;
+        count[s] = n - start[s] < segment ? n - start[s] : segment;
+    }
+}
+
+static void encodeRun(BitWriter* w, const uint64_t codes[], const uint8_t lengths[], const uint8_t* raw, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        writeBits(w, codes[raw[i]], lengths[raw[i]]);
+    }
+    flushBits(w);
+}
+
+static void compressBlock(CodecSlot* slot, int streams) {
+    uint64_t counts[MAX_ALPHABET_SIZE] = {0};
+    uint64_t streamCounts[INTERLEAVED_STREAMS][MAX_ALPHABET_SIZE];
+    uint64_t codes[MAX_ALPHABET_SIZE];
+    uint8_t lengths[MAX_ALPHABET_SIZE];
+    size_t start[INTERLEAVED_STREAMS], count[INTERLEAVED_STREAMS], streamBytes[INTERLEAVED_STREAMS];
+    const uint8_t* raw = slot->in;
+    size_t n = slot->inSize;
+
+    splitSegments(n, streams, start, count);
+    for (int s = 0; s < streams; s++) {
+        memset(streamCounts[s], 0, sizeof streamCounts[s]);
+        countBytes(raw + start[s], count[s], streamCounts[s]);
+        for (int c = 0; c < MAX_ALPHABET_SIZE; c++) counts[c] += streamCounts[s][c];
+    }
+    int worthCoding = (entropyBitsPerByte(counts) <= STORE_ENTROPY_BITS);
+    if (worthCoding && !huffmanLengthsFromCounts(counts, lengths, codeLimit)) {
+        slot->failed = 1;
+        return;
+    }
+    if (worthCoding) assignCanonicalCodes(lengths, codes);
+
+    // The histograms give the exact size of every stream before anything is written
+    size_t jumpTable = (size_t)(streams - 1) * 4;
+    size_t payload = jumpTable;
+    for (int s = 0; s < streams && worthCoding; s++) {
+        uint64_t bits = 0;
+        for (int c = 0; c < MAX_ALPHABET_SIZE; c++) bits += streamCounts[s][c] * lengths[c];
+        streamBytes[s] = (size_t)((bits + 7) / 8);
+        payload += streamBytes[s];
+    }
+    if (!worthCoding) payload = n;
+
+    uint8_t* header = slot->out;
+    putLE32(header, (uint32_t)n);
+    if (payload >= n) {
+        putLE32(header + 4, (uint32_t)n);
+        memset(header + 8, 0, MAX_ALPHABET_SIZE);
+        memcpy(header + BLOCK_HEADER_SIZE, raw, n);
+        slot->outSize = BLOCK_HEADER_SIZE + n;
+        return;
+    }
+    putLE32(header + 4, (uint32_t)payload);
+    memcpy(header + 8, lengths, MAX_ALPHABET_SIZE);
+    slot->outSize = BLOCK_HEADER_SIZE + payload;
+    uint8_t* data = header + BLOCK_HEADER_SIZE;
+    if (streams == 1) {
+        BitWriter writer = { data, 0, 0, 0 };
+        encodeRun(&writer, codes, lengths, raw, n);
+        return;
+    }
+
+    // A writer only stores words it has filled, so neighbouring streams never overlap
+    BitWriter w[INTERLEAVED_STREAMS];
+    size_t offset = jumpTable;
+    for (int s = 0; s < streams; s++) {
+        if (s < streams - 1) putLE32(data + 4 * s, (uint32_t)streamBytes[s]);
+        w[s] = (BitWriter){ data + offset, 0, 0, 0 };
+        offset += streamBytes[s];
+    }
+    // The last segment is the shortest: step all four streams together over its length
+    size_t common = count[INTERLEAVED_STREAMS - 1];
+    const uint8_t* r0 = raw + start[0], *r1 = raw + start[1], *r2 = raw + start[2], *r3 = raw + start[3];
+    for (size_t i = 0; i < common; i++) {
+        writeBits(&w[0], codes[r0[i]], lengths[r0[i]]);
+        writeBits(&w[1], codes[r1[i]], lengths[r1[i]]);
+        writeBits(&w[2], codes[r2[i]], lengths[r2[i]]);
+        writeBits(&w[3], codes[r3[i]], lengths[r3[i]]);
+    }
+    for (int s = 0; s < streams; s++) {
+        encodeRun(&w[s], codes, lengths, raw + start[s] + common, count[s] - common);
+    }
+}
+
+static void decompressBlock(CodecSlot* slot, int streams) {
+    uint64_t codes[MAX_ALPHABET_SIZE];
+    int stored = 1;
+    for (int c = 0; c < MAX_ALPHABET_SIZE && stored; c++) {
+        stored = (slot->lengths[c] == 0);
+    }
+    if (stored) {
+        slot->failed = (slot->inSize != slot->outSize);
+        memcpy(slot->out, slot->in, slot->inSize < slot->outSize ? slot->inSize : slot->outSize);
+        return;
+    }
+    if (!assignCanonicalCodes(slot->lengths, codes)) {
+        slot->failed = 1;
+        return;
+    }
+    HuffmanDecoder* decoder = createDecoder(codes, slot->lengths);
+    if (decoder == NULL) {
+        slot->failed = 1;
+        return;
+    }
+    if (streams == 1) {
+        slot->failed = !decodeWithTable(decoder, slot->in, slot->inSize, slot->outSize, slot->out);
+        freeDecoder(decoder);
+        return;
+    }
+
+    // Jump table: where each stream starts; the last one runs to the end of the payload
+    size_t start[INTERLEAVED_STREAMS], count[INTERLEAVED_STREAMS];
+    BitReader r[INTERLEAVED_STREAMS];
+    uint8_t* out[INTERLEAVED_STREAMS];
+    size_t jumpTable = (size_t)(streams - 1) * 4;
+    size_t offset = jumpTable;
+    slot->failed = (slot->inSize < jumpTable);
+    splitSegments(slot->outSize, streams, start, count);
+    for (int s = 0; s < streams && !slot->failed; s++) {
+        size_t size = s < streams - 1 ? getLE32(slot->in + 4 * s) : slot->inSize - offset;
+        if (size > slot->inSize - offset) {
+            slot->failed = 1;
+            break;
+        }
+        r[s] = (BitReader){ slot->in + offset, 0, size, 0, 0 };
+        out[s] = slot->out + start[s];
+        offset += size;
+    }
+    if (!slot->failed) {
+        slot->failed = !decodeInterleaved(decoder, r, out, count);
+    }
+    freeDecoder(decoder);
+}
+
+static void* codecWorker(void* arg) {
+    CodecPipeline* p = (CodecPipeline*)arg;
+    pthread_mutex_lock(&p->lock);
+    for (;;) {
+        while (!p->stop && p->claimed == p->filled) {
+            pthread_cond_wait(&p->work, &p->lock);
+        }
+        if (p->claimed == p->filled) {
+            break; // Stopped and nothing left to code
+        }
+        CodecSlot* slot = &p->slots[p->claimed++ % p->slotCount];
+        pthread_mutex_unlock(&p->lock);
+
+        if (p->compress) compressBlock(slot, p->streams);
+        else decompressBlock(slot, p->streams);
+
+        pthread_mutex_lock(&p->lock);
+        slot->state = SLOT_DONE;
+        pthread_cond_broadcast(&p->done);
+    }
+    pthread_mutex_unlock(&p->lock);
+    return NULL;
+}
 
-// --- 7. Main Program Execution ---
-int main() {
+// Reads the next block into 'slot'. Returns 1 if filled, 0 at the end, or -1 on bad input.
+static int readBlock(CodecSlot* slot, FILE* in, int compress) {
+    if (compress) {
+        slot->inSize = fread(slot->in, 1, CODEC_BLOCK_SIZE, in);
+        return slot->inSize > 0 ? 1 : (ferror(in) ? -1 : 0);
+    }
+    uint8_t header[BLOCK_HEADER_SIZE];
+    if (fread(header, 1, 4, in) != 4) {
+        return -1; // The end marker is missing
+    }
+    uint32_t rawSize = getLE32(header);
+    if (rawSize == 0) {
+        return 0;
+    }
+    if (fread(header + 4, 1, BLOCK_HEADER_SIZE - 4, in) != BLOCK_HEADER_SIZE - 4) {
+        return -1;
+    }
+    uint32_t payloadSize = getLE32(header + 4);
+    if (rawSize > CODEC_BLOCK_SIZE || payloadSize > CODEC_BLOCK_SIZE ||
+        fread(slot->in, 1, payloadSize, in) != payloadSize) {
+        return -1;
+    }
+    slot->inSize = payloadSize;
+    slot->outSize = rawSize;
+    memcpy(slot->lengths, header + 8, MAX_ALPHABET_SIZE);
+    return 1;
+}
+
+static int codecThreadCount(void) {
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    if (cores < 1) return 1;
+    return cores > CODEC_MAX_THREADS ? CODEC_MAX_THREADS : (int)cores;
+}
+
+/*
+ * Runs the read / code / write pipeline from 'in' to 'out'. Counts the
+ * bytes read and written (container framing included). Returns NULL on
+ * success or a message describing what went wrong.
+ */
+static const char* runCodecPipeline(FILE* in, FILE* out, int compress, int streams, uint64_t* inBytes, uint64_t* outBytes) {
+    const char* error = NULL;
+    int threads = codecThreadCount();
+    CodecPipeline p;
+    p.slotCount = 2 * threads;
+    p.compress = compress;
+    p.streams = streams;
+    p.filled = p.claimed = 0;
+    p.stop = 0;
+    p.slots = (CodecSlot*)calloc((size_t)p.slotCount, sizeof(CodecSlot));
+    if (p.slots == NULL) {
+        return "out of memory";
+    }
+    for (int s = 0; s < p.slotCount; s++) {
+        p.slots[s].in = (uint8_t*)malloc(BLOCK_BUFFER_SIZE);
+        p.slots[s].out = (uint8_t*)malloc(BLOCK_HEADER_SIZE + BLOCK_BUFFER_SIZE);
+        if (p.slots[s].in == NULL || p.slots[s].out == NULL) {
+            error = "out of memory";
+        }
+    }
+    pthread_mutex_init(&p.lock, NULL);
+    pthread_cond_init(&p.work, NULL);
+    pthread_cond_init(&p.done, NULL);
+
+    pthread_t tids[CODEC_MAX_THREADS];
+    int started = 0;
+    while (error == NULL && started < threads &&
+           pthread_create(&tids[started], NULL, codecWorker, &p) == 0) {
+        started++;
+    }
+    if (error == NULL && started == 0) {
+        error = "cannot start worker threads";
+    }
+
+    uint64_t written = 0;
+    int atEnd = 0;
+    while (error == NULL) {
+        // Keep every free slot filled, then write the oldest block once it is done
+        while (!atEnd && p.filled - written < (uint64_t)p.slotCount) {
+            CodecSlot* slot = &p.slots[p.filled % p.slotCount];
+            int status = readBlock(slot, in, compress);
+            if (status <= 0) {
+                atEnd = 1;
+                if (status < 0) error = compress ? "read error" : "truncated or corrupt container";
+                break;
+            }
+            *inBytes += compress ? slot->inSize : BLOCK_HEADER_SIZE + slot->inSize;
+            slot->state = SLOT_FILLED;
+            slot->failed = 0;
+            pthread_mutex_lock(&p.lock);
+            p.filled++;
+            pthread_cond_signal(&p.work);
+            pthread_mutex_unlock(&p.lock);
+        }
+        if (error != NULL || written == p.filled) {
+            break;
+        }
+
+        CodecSlot* slot = &p.slots[written % p.slotCount];
+        pthread_mutex_lock(&p.lock);
+        while (slot->state != SLOT_DONE) {
+            pthread_cond_wait(&p.done, &p.lock);
+        }
+        pthread_mutex_unlock(&p.lock);
+        if (slot->failed) {
+            error = compress ? "cannot build codes" : "corrupt payload";
+            break;
+        }
+        if (fwrite(slot->out, 1, slot->outSize, out) != slot->outSize) {
+            error = "write error";
+            break;
+        }
+        *outBytes += slot->outSize;
+        slot->state = SLOT_FREE;
+        written++;
+    }
+
+    pthread_mutex_lock(&p.lock);
+    p.stop = 1;
+    pthread_cond_broadcast(&p.work);
+    pthread_mutex_unlock(&p.lock);
+    for (int t = 0; t < started; t++) {
+        pthread_join(tids[t], NULL);
+    }
+    pthread_mutex_destroy(&p.lock);
+    pthread_cond_destroy(&p.work);
+    pthread_cond_destroy(&p.done);
+    for (int s = 0; s < p.slotCount; s++) {
+        free(p.slots[s].in);
+        free(p.slots[s].out);
+    }
+    free(p.slots);
+    return error;
+}
+
+// Returns NULL on success or a message describing what went wrong
+const char* compressFile(const char* inPath, const char* outPath, uint64_t* inBytes, uint64_t* outBytes) {
+    FILE* in = fopen(inPath, "rb");
+    if (in == NULL) {
+        return "cannot open input";
+    }
+    FILE* out = fopen(outPath, "wb");
+    if (out == NULL) {
+        fclose(in);
+        return "cannot open output";
+    }
+
+    const char* error = NULL;
+    uint8_t endMarker[4] = {0};
+    *inBytes = 0;
+    const char* magic = codecStreams == 1 ? HUFFMAN_MAGIC : INTERLEAVED_MAGIC;
+    *outBytes = sizeof HUFFMAN_MAGIC + sizeof endMarker;
+    if (fwrite(magic, 1, sizeof HUFFMAN_MAGIC, out) != sizeof HUFFMAN_MAGIC) {
+        error = "write error";
+    }
+    if (error == NULL) {
+        error = runCodecPipeline(in, out, 1, codecStreams, inBytes, outBytes);
+    }
+    if (error == NULL && fwrite(endMarker, 1, sizeof endMarker, out) != sizeof endMarker) {
+        error = "write error";
+    }
+    fclose(in);
+    if (fclose(out) != 0 && error == NULL) error = "write error";
+    return error;
+}
+
+const char* decompressFile(const char* inPath, const char* outPath, uint64_t* outBytes) {
+    FILE* in = fopen(inPath, "rb");
+    if (in == NULL) {
+        return "cannot open input";
+    }
+    char magic[sizeof HUFFMAN_MAGIC];
+    int streams = 0;
+    if (fread(magic, 1, sizeof magic, in) == sizeof magic) {
+        if (memcmp(magic, HUFFMAN_MAGIC, sizeof magic) == 0) streams = 1;
+        else if (memcmp(magic, INTERLEAVED_MAGIC, sizeof magic) == 0) streams = INTERLEAVED_STREAMS;
+    }
+    if (streams == 0) {
+        fclose(in);
+        return "not a Huffman container";
+    }
+    FILE* out = fopen(outPath, "wb");
+    if (out == NULL) {
+        fclose(in);
+        return "cannot open output";
+    }
+
+    uint64_t inBytes = 0;
+    *outBytes = 0;
+    const char* error = runCodecPipeline(in, out, 0, streams, &inBytes, outBytes);
+    fclose(in);
+    if (fclose(out) != 0 && error == NULL) error = "write error";
+    return error;
+}
+
+// Byte histogram of a whole file, read block by block. Returns NULL on success.
+const char* countFileBytes(const char* path, uint64_t counts[], uint64_t* total) {
+    FILE* in = fopen(path, "rb");
+    if (in == NULL) {
+        return "cannot open input";
+    }
+    uint8_t* chunk = (uint8_t*)malloc(CODEC_BLOCK_SIZE);
+    if (chunk == NULL) {
+        fclose(in);
+        return "out of memory";
+    }
+    size_t got;
+    *total = 0;
+    while ((got = fread(chunk, 1, CODEC_BLOCK_SIZE, in)) > 0) {
+        countBytes(chunk, got, counts);
+        *total += got;
+    }
+    const char* error = ferror(in) ? "read error" : NULL;
+    fclose(in);
+    free(chunk);
+    return error;
+}
+
+// Handles "-c <in> <out>", "-d <in> <out>" and "-e <file>". Returns -1 if none was given.
+static int runFileMode(int argc, char *argv[]) {
+    for (int a = 1; a + 1 < argc; a++) {
+        if (strcmp(argv[a], "-e") == 0) {
+            uint64_t counts[MAX_ALPHABET_SIZE] = {0};
+            uint64_t total = 0;
+            const char* error = countFileBytes(argv[a + 1], counts, &total);
+            if (error != NULL) {
+                printf("Error: %s.\n", error);
+                return EXIT_FAILURE;
+            }
+            double entropy = entropyBitsPerByte(counts);
+            REPORT(VERBOSITY_SUMMARY, "%" PRIu64 " bytes, %.4f bits per byte: at best %.0f bytes when coded byte by byte.\n",
+                   total, entropy, ceil(entropy * (double)total / 8.0));
+            return EXIT_SUCCESS;
+        }
+    }
+    for (int a = 1; a + 2 < argc; a++) {
+        int compress = (strcmp(argv[a], "-c") == 0);
+        if (!compress && strcmp(argv[a], "-d") != 0) continue;
+
+        uint64_t inBytes = 0, outBytes = 0;
+        const char* error = compress ? compressFile(argv[a + 1], argv[a + 2], &inBytes, &outBytes)
+                                     : decompressFile(argv[a + 1], argv[a + 2], &outBytes);
+        if (error != NULL) {
+            printf("Error: %s.\n", error);
+            return EXIT_FAILURE;
+        }
+        if (compress) {
+            REPORT(VERBOSITY_SUMMARY, "Compressed %" PRIu64 " bytes into %" PRIu64 " bytes.\n", inBytes, outBytes);
+        } else {
+            REPORT(VERBOSITY_SUMMARY, "Decompressed %" PRIu64 " bytes.\n", outBytes);
+        }
+        return EXIT_SUCCESS;
+    }
+    return -1;
+}
+
+// --- 8. Main Program Execution ---
+int main(int argc, char *argv[]) {
     char inputString[MAX_INPUT_LENGTH];
-    int charCounts[MAX_ALPHABET_SIZE] = {0}; // Initialize all counts to 0
+    char decodedString[MAX_INPUT_LENGTH];
+    uint64_t charCounts[MAX_ALPHABET_SIZE] = {0}; // Initialize all counts to 0
     int distinctChars = 0;
+
+    parseOptions(argc, argv);
+
+    // File mode: compress or decompress whole files instead of one line of text
+    int fileStatus = runFileMode(argc, argv);
+    if (fileStatus != -1) {
+        return fileStatus;
+    }
     
     // Get the input string from the user
-    printf("Enter the text to encode (max %d characters):\n", MAX_INPUT_LENGTH - 1);
+    REPORT(VERBOSITY_FULL, "Enter the text to encode (max %d characters):\n", MAX_INPUT_LENGTH - 1);
     if (fgets(inputString, MAX_INPUT_LENGTH, stdin) == NULL) {
         printf("Error reading input.\n");
         return EXIT_FAILURE;
@@ -132,13 +1263,10 @@ int main() {
     }
     
     // --- Step 1: Calculate Frequencies ---
-    printf("\n--- i. Character Frequencies ---\n");
-    for (int i = 0; inputString[i] != '\0'; i++) {
-        unsigned char c = inputString[i];
-        if (charCounts[c] == 0) {
-            distinctChars++;
-        }
-        charCounts[c]++;
+    REPORT(VERBOSITY_FULL, "\n--- i. Character Frequencies ---\n");
+    countBytes((const uint8_t*)inputString, len, charCounts);
+    for (int c = 0; c < MAX_ALPHABET_SIZE; c++) {
+        distinctChars += (charCounts[c] > 0);
     }
     
     if (distinctChars < 2) {
@@ -146,75 +1274,71 @@ int main() {
         return EXIT_FAILURE;
     }
 
-    // --- Step 2: Build Initial Nodes ---
-    Node** nodes = (Node**)malloc(distinctChars * sizeof(Node*));
-    if (nodes == NULL) {
-        perror("Initial memory allocation failed");
+    // --- Step 2 & 3: Build the Huffman Tree (Greedy) and its code lengths ---
+    for (int i = 0; i < MAX_ALPHABET_SIZE; i++) {
+        if (charCounts[i] > 0) {
+            REPORT(VERBOSITY_FULL, "  '%c': %" PRIu64 "\n", (char)i, charCounts[i]);
+        }
+    }
+    uint8_t lengths[MAX_ALPHABET_SIZE];
+    uint64_t codes[MAX_ALPHABET_SIZE];
+    if (!huffmanLengthsFromCounts(charCounts, lengths, codeLimit)) {
+        printf("Error: Could not build the Huffman codes.\n");
         return EXIT_FAILURE;
     }
 
+    // --- Step 4: Generate Huffman Codes ---
+    // Canonical codes from the lengths, kept as (code, length) integers
+    assignCanonicalCodes(lengths, codes);
 
-    int nodeIndex = 0;
-    for (int i = 0; i < MAX_ALPHABET_SIZE; i++) {
+    REPORT(VERBOSITY_FULL, "\n--- ii. Corresponding Huffman Codes ---\n");
+    for (int i = 0; verbosity == VERBOSITY_FULL && i < MAX_ALPHABET_SIZE; i++) {
         if (charCounts[i] > 0) {
-            
-            printf("  '%c': %d\n", (char)i, charCounts[i]);
-            nodes[nodeIndex++] = createNode((char)i, charCounts[i]);
+            printf("  '%c' (Freq: %" PRIu64 "): ", (char)i, charCounts[i]);
+            printCode(codes[i], lengths[i]);
+            printf("\n");
         }
     }
 
-    // --- Step 3: Build the Huffman Tree (Greedy) ---
-    Node* root = buildHuffmanTree(nodes, distinctChars);
-
-    // --- Step 4: Generate Huffman Codes ---
-    printf("\n--- ii. Corresponding Huffman Codes ---\n");
-    char codeBuffer[MAX_ALPHABET_SIZE]; 
-    generateCodes(root, codeBuffer, 0);
-
     // --- Step 5: Encoded Binary String  ---
-    printf("\n--- iii. Encoded Binary String ---\n");
-    printf("Original Text: %s\n", inputString);
-    printf("Encoded String: ");
+    REPORT(VERBOSITY_FULL, "\n--- iii. Encoded Binary String ---\n");
+    REPORT(VERBOSITY_FULL, "Original Text: %s\n", inputString);
+    REPORT(VERBOSITY_FULL, "Encoded String: ");
 
     int totalBits = 0;
     for (int i = 0; inputString[i] != '\0'; i++) {
         unsigned char c = inputString[i];
-        char* code = codeTable[c];
-        printf("%s", code);
-        totalBits += (int)strlen(code);
+        if (verbosity == VERBOSITY_FULL) printCode(codes[c], lengths[c]);
+        totalBits += lengths[c];
     }
     
-    printf("\nTotal Bits: %d\n", totalBits);
+    REPORT(VERBOSITY_FULL, "\n");
+    REPORT(VERBOSITY_SUMMARY, "Total Bits: %d\n", totalBits);
 
     // --- Step 6: Decoded Text ---
-    printf("\n--- iv. Decoded (Original) Text ---\n");
-    printf("Decoded Text: ");
-
-    Node* current = root;
-    // We traverse the tree based on the generated codes to simulate decoding.
-    for (int i = 0; inputString[i] != '\0'; i++) {
+    // Pack the codes into real bits and decode them with the lookup tables
+    uint8_t packed[MAX_INPUT_LENGTH * MAX_CODE_BITS / 8 + 16]; // Room for the last whole word
+    HuffmanDecoder* decoder = createDecoder(codes, lengths);
+    if (decoder == NULL) {
+        printf("Error: Could not build the decode tables.\n");
+        return EXIT_FAILURE;
+    }
+    BitWriter writer = { packed, 0, 0, 0 };
+    for (size_t i = 0; i < len; i++) {
         unsigned char c = inputString[i];
-        char* code = codeTable[c];
-        
-        for (int j = 0; code[j] != '\0'; j++) {
-            if (code[j] == '0') {
-                current = current->left;
-            } else { 
-                current = current->right;
-            }
-            
-            // If we hit a leaf, print the character and restart from the root.
-            if (current->left == NULL && current->right == NULL) {
-                printf("%c", current->data);
-                current = root;
-            }
-        }
+        writeBits(&writer, codes[c], lengths[c]);
     }
-    printf("\n-----------------------------------\n");
+    flushBits(&writer);
+    if (!decodeWithTable(decoder, packed, writer.pos, len, (uint8_t*)decodedString)) {
+        printf("Error: Corrupt bitstream.\n");
+        len = 0;
+    }
+    decodedString[len] = '\0';
+    freeDecoder(decoder);
+
+    REPORT(VERBOSITY_FULL, "\n--- iv. Decoded (Original) Text ---\n");
+    REPORT(VERBOSITY_FULL, "Decoded Text: %s\n", decodedString);
+    REPORT(VERBOSITY_FULL, "-----------------------------------\n");
 
-    // --- Final Cleanup ---
-    freeHuffmanTree(root);
-    free(nodes);
-    
     return 0;
 }
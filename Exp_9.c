@@ -1,89 +1,954 @@
+#define _POSIX_C_SOURCE 200809L // sysconf, sched_yield
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+#include <time.h>
+#include <unistd.h>
+#include <sched.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#ifdef __AVX__
+#include <immintrin.h>
+#endif
+
+// Alignment of the heap-allocated ratio column (one cache line, >= one AVX vector)
+#define SOA_ALIGNMENT 64
+// Items added per capacity size in the row-kernel benchmark (-b)
+#define BENCHMARK_ITEMS 8
+// knapsackDP splits rows over up to DP_MAX_THREADS (build with -pthread) from this capacity upward
+#define DP_PARALLEL_MIN_CAPACITY (1 << 20)
+#define DP_MAX_THREADS 64
+// Items per tile, cells per cache block, and the largest tile halo as a fraction (1/DP_HALO_DIVISOR) of a block
+#define DP_TILE_ITEMS 8
+#define DP_BLOCK_CELLS (1 << 16)
+#define DP_HALO_DIVISOR 4
+// Barrier spins before a waiting thread starts yielding the core
+#define BARRIER_SPINS 1000
+// A Pareto state or a branch-and-bound node costs about as much as this many
+// dense DP cells; instances with n*W up to DENSE_DP_CHEAP_CELLS go straight to the DP
+#define PARETO_COST_RATIO 16
+#define BRANCH_COST_RATIO 16
+#define DENSE_DP_CHEAP_CELLS (1LL << 26)
+// Branch and bound and the Pareto solver may each spend 1/TRIAL_COST_SHARE of the DP's cost before it runs
+#define TRIAL_COST_SHARE 4
+// Most nodes branch and bound may spend proving an optimum before solveKnapsack01 tries the other engines
+#define BRANCH_NODE_LIMIT 50000000
 
 // Helper function to find the maximum of two integers
 int max(int a, int b) {
     return (a > b) ? a : b;
 }
 
+/*
+ * One item's DP row update: row[w] = max(row[w], value + row[w - weight])
+ * for w = C down to weight. Cells below 'weight' cannot take the item, so
+ * the loop starts at that split point instead of testing every cell.
+ * Walking w downwards reads only cells not yet updated for this item, so
+ * one row is enough.
+ */
+void rowUpdateScalar32(int row[], int C, int weight, int value) {
+    for (int w = C; w >= weight; w--) {
+        row[w] = max(row[w], value + row[w - weight]);
+    }
+}
+
+void rowUpdateScalar64(long long row[], int C, int weight, long long value) {
+    for (int w = C; w >= weight; w--) {
+        long long take = value + row[w - weight];
+        if (take > row[w]) row[w] = take;
+    }
+}
+
+/*
+ * Vector versions: a block of lanes is the elementwise max of itself and
+ * the row shifted down by 'weight' plus the value. Blocks also go from
+ * the top down, and each block loads its source before storing, so a
+ * weight smaller than the vector still reads only old cells.
+ * rowUpdate32 leaves cells below 'low' alone as well, for callers that
+ * only need the top of the row.
+ */
+void rowUpdate32(int row[], int low, int C, int weight, int value) {
+    int stop = low > weight ? low : weight;
+    int w = C;
+    // Scalar cells at the top until vector stores start on a cache line
+    for (; w >= stop && ((uintptr_t)&row[w + 1] % SOA_ALIGNMENT) != 0; w--) {
+        row[w] = max(row[w], value + row[w - weight]);
+    }
+#if defined(__AVX512F__)
+    const __m512i add16 = _mm512_set1_epi32(value);
+    for (; w - 15 >= stop; w -= 16) {
+        __m512i keep = _mm512_loadu_si512((const void *)&row[w - 15]);
+        __m512i take = _mm512_add_epi32(_mm512_loadu_si512((const void *)&row[w - 15 - weight]), add16);
+        _mm512_storeu_si512((void *)&row[w - 15], _mm512_max_epi32(keep, take));
+    }
+#endif
+#if defined(__AVX2__)
+    const __m256i add8 = _mm256_set1_epi32(value);
+    for (; w - 7 >= stop; w -= 8) {
+        __m256i keep = _mm256_loadu_si256((const __m256i *)&row[w - 7]);
+        __m256i take = _mm256_add_epi32(_mm256_loadu_si256((const __m256i *)&row[w - 7 - weight]), add8);
+        _mm256_storeu_si256((__m256i *)&row[w - 7], _mm256_max_epi32(keep, take));
+    }
+#endif
+    for (; w >= stop; w--) {
+        row[w] = max(row[w], value + row[w - weight]);
+    }
+}
+
+void rowUpdate64(long long row[], int C, int weight, long long value) {
+    int w = C;
+    for (; w >= weight && ((uintptr_t)&row[w + 1] % SOA_ALIGNMENT) != 0; w--) {
+        long long take = value + row[w - weight];
+        if (take > row[w]) row[w] = take;
+    }
+#if defined(__AVX512F__)
+    const __m512i add8 = _mm512_set1_epi64(value);
+    for (; w - 7 >= weight; w -= 8) {
+        __m512i keep = _mm512_loadu_si512((const void *)&row[w - 7]);
+        __m512i take = _mm512_add_epi64(_mm512_loadu_si512((const void *)&row[w - 7 - weight]), add8);
+        _mm512_storeu_si512((void *)&row[w - 7], _mm512_max_epi64(keep, take));
+    }
+#endif
+#if defined(__AVX2__)
+    // AVX2 has no 64-bit max: compare, then blend
+    const __m256i add4 = _mm256_set1_epi64x(value);
+    for (; w - 3 >= weight; w -= 4) {
+        __m256i keep = _mm256_loadu_si256((const __m256i *)&row[w - 3]);
+        __m256i take = _mm256_add_epi64(_mm256_loadu_si256((const __m256i *)&row[w - 3 - weight]), add4);
+        __m256i better = _mm256_cmpgt_epi64(take, keep);
+        _mm256_storeu_si256((__m256i *)&row[w - 3], _mm256_blendv_epi8(keep, take, better));
+    }
+#endif
+    rowUpdateScalar64(row, w, weight, value);
+}
+
+// Adds items [lo, hi) to a DP row over capacities 0..C; row[w] is the best value within weight w.
+void knapsackRow(int row[], int C, const int weights[], const int values[], int lo, int hi) {
+    for (int i = lo; i < hi; i++) {
+        rowUpdate32(row, 0, C, weights[i], values[i]);
+    }
+}
+
+/*
+ * Parallel DP across the capacity dimension. Each thread owns a slice
+ * [lo, hi) of the row and the threads stay alive for the whole run.
+ * Rows are double-buffered: a pass reads 'prev' and writes 'next', then
+ * all threads meet at a barrier and swap.
+ *
+ * A pass adds a tile of up to DP_TILE_ITEMS items. A thread walks its
+ * slice in blocks of DP_BLOCK_CELLS, copying each block plus a halo below
+ * it (the tile's total weight) into a private buffer. It runs the items
+ * there with the single-row update, the lower cells dropping out item by
+ * item, and writes the block back. A block stays in cache across the
+ * tile, and there is one barrier per tile instead of one per item. The
+ * halo is recomputed for every block, so tiles stop growing once the
+ * halo would exceed 1/DP_HALO_DIVISOR of a block. An item heavier than
+ * that forms a tile of its own and goes straight from 'prev' to 'next'.
+ */
+typedef struct {
+    atomic_int remaining;
+    atomic_int sense;
+    int parties;
+} SpinBarrier;
+
+// Sense-reversing barrier: spin briefly, then yield so oversubscribed cores still progress
+static void barrierWait(SpinBarrier *b, int *localSense) {
+    int sense = !*localSense;
+    *localSense = sense;
+    if (atomic_fetch_sub(&b->remaining, 1) == 1) {
+        atomic_store(&b->remaining, b->parties);
+        atomic_store(&b->sense, sense);
+        return;
+    }
+    for (int spins = 0; atomic_load(&b->sense) != sense; spins++) {
+        if (spins >= BARRIER_SPINS) sched_yield();
+    }
+}
+
+typedef struct {
+    int W, n, threads, slice, block;
+    const int *weights;
+    const int *values;
+    int *rows[2];
+    int finalRow;   // Row holding the result, set by thread 0
+    atomic_int go;  // 0 until every thread exists, then 1 (run) or -1 (give up)
+    SpinBarrier barrier;
+} ParallelDP;
+
+typedef struct {
+    ParallelDP *dp;
+    int id;
+    int *scratch; // slice + halo cells
+} DPTask;
+
+// End of the tile starting at item 'first'; all threads compute the same tiles
+static int tileEnd(const ParallelDP *dp, int first, int *halo) {
+    int last = first;
+    *halo = 0;
+    while (last < dp->n && last - first < DP_TILE_ITEMS) {
+        int w = dp->weights[last];
+        if (w <= dp->W) {
+            if (last > first && *halo + w > dp->block / DP_HALO_DIVISOR) break;
+            *halo += w;
+        }
+        last++;
+    }
+    return last;
+}
+
+// Out-of-place update of cells [lo, hi): dst[w] = max(src[w], value + src[w - weight])
+static void rowUpdateInto32(int *dst, const int *src, int lo, int hi, int weight, int value) {
+    int split = weight < lo ? lo : (weight < hi ? weight : hi);
+    memcpy(dst + lo, src + lo, (size_t)(split - lo) * sizeof(int));
+    for (int w = split; w < hi; w++) {
+        dst[w] = max(src[w], value + src[w - weight]);
+    }
+}
+
+// Adds items [first, last) to cells [lo, hi) through the scratch buffer
+static void runTileBlock(const ParallelDP *dp, int cur, int *cells, int lo, int hi, int first, int last, int halo) {
+    const int *prev = dp->rows[cur];
+    int base = lo - halo > 0 ? lo - halo : 0; // Row cell held in cells[0]
+    memcpy(cells, prev + base, (size_t)(hi - base) * sizeof(int));
+    // Item k only needs to be right from lo minus the weight still to come
+    int later = halo;
+    for (int i = first; i < last; i++) {
+        if (dp->weights[i] > dp->W) continue;
+        later -= dp->weights[i];
+        int low = lo - later > 0 ? lo - later : 0;
+        rowUpdate32(cells, low - base, hi - 1 - base, dp->weights[i], dp->values[i]);
+    }
+    memcpy(dp->rows[1 - cur] + lo, cells + (lo - base), (size_t)(hi - lo) * sizeof(int));
+}
+
+static void *dpWorker(void *arg) {
+    DPTask *task = (DPTask *)arg;
+    ParallelDP *dp = task->dp;
+    int lo = task->id * dp->slice;
+    int hi = lo + dp->slice > dp->W + 1 ? dp->W + 1 : lo + dp->slice;
+    int localSense = 0, cur = 0;
+    int go;
+    while ((go = atomic_load(&dp->go)) == 0) sched_yield();
+    if (go < 0) {
+        return NULL;
+    }
+
+    for (int first = 0; first < dp->n;) {
+        int halo;
+        int last = tileEnd(dp, first, &halo);
+        if (halo > dp->block / DP_HALO_DIVISOR) {
+            if (lo < hi) {
+                rowUpdateInto32(dp->rows[1 - cur], dp->rows[cur], lo, hi, dp->weights[first], dp->values[first]);
+            }
+        } else {
+            for (int b = lo; b < hi; b += dp->block) {
+                int end = hi - b > dp->block ? b + dp->block : hi;
+                runTileBlock(dp, cur, task->scratch, b, end, first, last, halo);
+            }
+        }
+        barrierWait(&dp->barrier, &localSense);
+        cur = 1 - cur;
+        first = last;
+    }
+    if (task->id == 0) {
+        dp->finalRow = cur;
+    }
+    return NULL;
+}
+
+static int dpThreadCount(void) {
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    if (cores < 1) return 1;
+    return cores > DP_MAX_THREADS ? DP_MAX_THREADS : (int)cores;
+}
+
+// Same result as the serial DP on 'threads' threads. Returns -1 if memory or threads run out.
+int knapsackDPParallel(int W, int weights[], int values[], int n, int threads) {
+    ParallelDP dp;
+    DPTask tasks[DP_MAX_THREADS];
+    pthread_t tids[DP_MAX_THREADS];
+    if (threads < 1) threads = 1;
+    if (threads > DP_MAX_THREADS) threads = DP_MAX_THREADS;
+
+    dp.W = W;
+    dp.n = n;
+    dp.threads = threads;
+    dp.slice = (W + 1 + threads - 1) / threads;
+    dp.block = dp.slice < DP_BLOCK_CELLS ? dp.slice : DP_BLOCK_CELLS;
+    dp.weights = weights;
+    dp.values = values;
+    dp.rows[0] = (int *)calloc((size_t)W + 1, sizeof(int));
+    dp.rows[1] = (int *)calloc((size_t)W + 1, sizeof(int));
+    atomic_init(&dp.barrier.remaining, threads);
+    atomic_init(&dp.barrier.sense, 0);
+    dp.barrier.parties = threads;
+
+    atomic_init(&dp.go, 0);
+
+    int ok = (dp.rows[0] != NULL && dp.rows[1] != NULL);
+    size_t scratchCells = (size_t)dp.block + dp.block / DP_HALO_DIVISOR + 1;
+    int allocated = 0;
+    while (ok && allocated < threads) {
+        tasks[allocated].dp = &dp;
+        tasks[allocated].id = allocated;
+        tasks[allocated].scratch = (int *)malloc(scratchCells * sizeof(int));
+        ok = (tasks[allocated++].scratch != NULL);
+    }
+    // The barrier counts every thread, so all must exist before any starts;
+    // the caller's thread works as thread 0
+    int started = 1;
+    while (ok && started < threads) {
+        ok = (pthread_create(&tids[started], NULL, dpWorker, &tasks[started]) == 0);
+        if (ok) started++;
+    }
+    atomic_store(&dp.go, ok ? 1 : -1);
+
+    int best = -1;
+    if (ok) {
+        dpWorker(&tasks[0]);
+    }
+    for (int t = 1; t < started; t++) {
+        pthread_join(tids[t], NULL);
+    }
+    if (ok) {
+        best = dp.rows[dp.finalRow][W];
+    }
+    for (int t = 0; t < allocated; t++) {
+        free(tasks[t].scratch);
+    }
+    free(dp.rows[0]);
+    free(dp.rows[1]);
+    return best;
+}
+
 // Function to solve the 0/1 Knapsack problem using Dynamic Programming
+// One rolling row of W + 1 values on the heap; returns -1 if memory allocation fails.
+// Large capacities use the tiled engine on one thread per core (tiling pays off even on one).
 int knapsackDP(int W, int weights[], int values[], int n) {
-   
-    int V[n + 1][W + 1]; 
-
-    for (int i = 0; i <= n; i++) {
-        for (int w = 0; w <= W; w++) {
-            // Base case: If no items (i=0) or no capacity (w=0), value is 0
-            if (i == 0 || w == 0) {
-                V[i][w] = 0;
-            } 
-            // Case 1: If weight of current item (weights[i-1]) is less than 
-           
-            else if (weights[i - 1] <= w) {
-               
-                V[i][w] = max(
-                    V[i - 1][w], 
-                    values[i - 1] + V[i - 1][w - weights[i - 1]]
-                );
-            } 
-            // Case 2: If weight of current item is greater than 'w', 
-            else {
-                V[i][w] = V[i - 1][w];
-            }
+    if (W >= DP_PARALLEL_MIN_CAPACITY) {
+        int best = knapsackDPParallel(W, weights, values, n, dpThreadCount());
+        if (best >= 0) {
+            return best;
         }
     }
+    int *row = (int *)calloc((size_t)W + 1, sizeof(int));
+    if (row == NULL) {
+        return -1;
+    }
+    knapsackRow(row, W, weights, values, 0, n);
 
     // The maximum value
-    return V[n][W];
+    int best = row[W];
+    free(row);
+    return best;
+}
+
+// Same DP with 64-bit values, for item sets whose total value overflows an int.
+// Returns -1 if memory allocation fails.
+long long knapsackDP64(int W, int weights[], int values[], int n) {
+    long long *row = (long long *)calloc((size_t)W + 1, sizeof(long long));
+    if (row == NULL) {
+        return -1;
+    }
+    for (int i = 0; i < n; i++) {
+        rowUpdate64(row, W, weights[i], values[i]);
+    }
+    long long best = row[W];
+    free(row);
+    return best;
 }
 
-// Struct to store item data for the Greedy approach
+/*
+ * Divide and conquer over the items (Hirschberg's idea): the best value
+ * for items [lo, mid) at every capacity and for [mid, hi) at every
+ * capacity tell how to split C between the two halves; each half is
+ * then solved alone. 'front' and 'back' are scratch rows of C + 1 and
+ * are free again once the split is known, so the whole recursion needs
+ * O(W) memory and about twice the DP's time.
+ */
+static int collectItems(int lo, int hi, int C, const int weights[], const int values[],
+                        int front[], int back[], int chosen[], int count) {
+    if (hi - lo == 1) {
+        if (weights[lo] <= C && values[lo] > 0) {
+            chosen[count++] = lo;
+        }
+        return count;
+    }
+    int mid = lo + (hi - lo) / 2;
+    for (int w = 0; w <= C; w++) front[w] = back[w] = 0;
+    knapsackRow(front, C, weights, values, lo, mid);
+    knapsackRow(back, C, weights, values, mid, hi);
+
+    int split = 0;
+    for (int c = 1; c <= C; c++) {
+        if (front[c] + back[C - c] > front[split] + back[C - split]) split = c;
+    }
+    count = collectItems(lo, mid, split, weights, values, front, back, chosen, count);
+    return collectItems(mid, hi, C - split, weights, values, front, back, chosen, count);
+}
+
+// Optimal item set: writes item indices in increasing order to chosen[] (room for n)
+// and returns how many there are, or -1 if memory allocation fails.
+int knapsackDPItems(int W, int weights[], int values[], int n, int chosen[]) {
+    if (n <= 0) {
+        return 0;
+    }
+    int *front = (int *)malloc(((size_t)W + 1) * sizeof(int));
+    int *back = (int *)malloc(((size_t)W + 1) * sizeof(int));
+    if (front == NULL || back == NULL) {
+        free(front);
+        free(back);
+        return -1;
+    }
+    int count = collectItems(0, n, W, weights, values, front, back, chosen, 0);
+    free(front);
+    free(back);
+    return count;
+}
+
+/*
+ * Nemhauser-Ullmann: the non-dominated (weight, value) pairs reachable
+ * with the items seen so far, sorted by weight with strictly rising
+ * value. Adding an item merges the list with a copy shifted by the
+ * item, dropping pairs over W and pairs that a lighter one beats, in
+ * linear time. Cost follows the frontier size, not W.
+ */
 typedef struct {
     int weight;
     int value;
-    float ratio; 
-} Item;
+} ParetoPoint;
+
+// Frontier of items [lo, hi) at capacity C: stores it in *frontier (the
+// caller frees it) and returns its size, -1 if memory allocation fails,
+// or -2 once it holds more than maxStates pairs (0 = no limit).
+static long paretoFrontier(int C, const int weights[], const int values[], int lo, int hi,
+                           size_t maxStates, ParetoPoint **frontier) {
+    size_t capacity = 1024, size = 1;
+    ParetoPoint *cur = (ParetoPoint *)malloc(capacity * sizeof(ParetoPoint));
+    ParetoPoint *next = (ParetoPoint *)malloc(capacity * sizeof(ParetoPoint));
+    if (cur == NULL || next == NULL) {
+        free(cur);
+        free(next);
+        return -1;
+    }
+    cur[0].weight = 0;
+    cur[0].value = 0;
+
+    for (int i = lo; i < hi; i++) {
+        int wt = weights[i], v = values[i];
+        if (wt > C) continue;
+        if (2 * size > capacity) {
+            capacity = 2 * size;
+            ParetoPoint *a = (ParetoPoint *)realloc(cur, capacity * sizeof(ParetoPoint));
+            if (a != NULL) cur = a;
+            ParetoPoint *b = (ParetoPoint *)realloc(next, capacity * sizeof(ParetoPoint));
+            if (b != NULL) next = b;
+            if (a == NULL || b == NULL) {
+                free(cur);
+                free(next);
+                return -1;
+            }
+        }
+
+        // Shifted pairs that still fit: cur[0 .. shifted)
+        size_t shifted = 0;
+        while (shifted < size && cur[shifted].weight <= C - wt) shifted++;
+
+        size_t a = 0, b = 0, out = 0;
+        while (a < size || b < shifted) {
+            ParetoPoint p;
+            if (b >= shifted || (a < size && cur[a].weight < cur[b].weight + wt)) {
+                p = cur[a++];
+            } else if (a >= size || cur[a].weight > cur[b].weight + wt) {
+                p.weight = cur[b].weight + wt;
+                p.value = cur[b++].value + v;
+            } else {
+                // Same weight in both lists: keep the better value
+                p.weight = cur[a].weight;
+                p.value = max(cur[a++].value, cur[b++].value + v);
+            }
+            if (out == 0 || p.value > next[out - 1].value) {
+                next[out++] = p;
+            }
+        }
+        ParetoPoint *t = cur;
+        cur = next;
+        next = t;
+        size = out;
+        if (maxStates > 0 && size > maxStates) {
+            free(cur);
+            free(next);
+            return -2;
+        }
+    }
+    free(next);
+    *frontier = cur;
+    return (long)size;
+}
 
-// Comparison function for qsort: sorts items by ratio in descending order
-int compareItems(const void *a, const void *b) {
-    float ratioA = ((Item *)a)->ratio;
-    float ratioB = ((Item *)b)->ratio;
+// Returns the best value, -1 if memory allocation fails, or -2 once the
+// frontier holds more than maxStates pairs (0 = no limit).
+int knapsackPareto(int W, int weights[], int values[], int n, size_t maxStates) {
+    ParetoPoint *frontier;
+    long size = paretoFrontier(W, weights, values, 0, n, maxStates, &frontier);
+    if (size < 0) {
+        return (int)size;
+    }
+    int best = frontier[size - 1].value; // Values rise along the frontier
+    free(frontier);
+    return best;
+}
+
+/*
+ * Same split as collectItems, on frontiers instead of rows: the best
+ * pair from [lo, mid) plus the heaviest pair from [mid, hi) that still
+ * fits gives the optimum, found by one sweep with the second index
+ * walking down, and the weights of that pair are the capacities the
+ * two halves are solved with. Each frontier is freed before recursing,
+ * so memory stays at the largest frontier.
+ */
+static int collectParetoItems(int lo, int hi, int C, const int weights[], const int values[],
+                              int chosen[], int count) {
+    if (hi - lo == 1) {
+        if (weights[lo] <= C && values[lo] > 0) {
+            chosen[count++] = lo;
+        }
+        return count;
+    }
+    int mid = lo + (hi - lo) / 2;
+    ParetoPoint *front, *back;
+    long frontSize = paretoFrontier(C, weights, values, lo, mid, 0, &front);
+    if (frontSize < 0) {
+        return -1;
+    }
+    long backSize = paretoFrontier(C, weights, values, mid, hi, 0, &back);
+    if (backSize < 0) {
+        free(front);
+        return -1;
+    }
+
+    long bestFront = 0, bestBack = 0, j = backSize - 1;
+    for (long i = 0; i < frontSize; i++) {
+        while (back[j].weight > C - front[i].weight) j--; // back[0] weighs 0 and always fits
+        if (front[i].value + back[j].value > front[bestFront].value + back[bestBack].value) {
+            bestFront = i;
+            bestBack = j;
+        }
+    }
+    int frontCapacity = front[bestFront].weight, backCapacity = back[bestBack].weight;
+    free(front);
+    free(back);
+    count = collectParetoItems(lo, mid, frontCapacity, weights, values, chosen, count);
+    if (count < 0) {
+        return -1;
+    }
+    return collectParetoItems(mid, hi, backCapacity, weights, values, chosen, count);
+}
+
+// Optimal item set from the Pareto frontiers, in the form knapsackDPItems
+// gives it; costs a few frontier builds and never depends on W.
+int knapsackParetoItems(int W, int weights[], int values[], int n, int chosen[]) {
+    if (n <= 0) {
+        return 0;
+    }
+    return collectParetoItems(0, n, W, weights, values, chosen, 0);
+}
+
+// weights[] and values[] already form a structure of arrays; the greedy
+// approach adds a double-precision ratio column and sorts small keys instead
+typedef struct {
+    double ratio;
+    int index;
+} RatioKey;
+
+// Comparison function for qsort: sorts keys by ratio in descending order
+int compareRatioKeys(const void *a, const void *b) {
+    double ratioA = ((const RatioKey *)a)->ratio;
+    double ratioB = ((const RatioKey *)b)->ratio;
 
     if (ratioA < ratioB) return 1;
     if (ratioA > ratioB) return -1;
     return 0;
 }
 
-// Function to solve the Knapsack problem using the Greedy approach
+/*
+ * ratio[i] = values[i] / weights[i], or +infinity for a zero weight (a free
+ * item always fits), without a branch: zero weights divide by 1 and are
+ * then blended to infinity. Four lanes at a time with AVX.
+ */
+void computeRatios(const int weights[], const int values[], double ratio[], int n) {
+    int i = 0;
+#ifdef __AVX__
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d one = _mm256_set1_pd(1.0);
+    const __m256d inf = _mm256_set1_pd(HUGE_VAL);
+    for (; i + 4 <= n; i += 4) {
+        __m256d w = _mm256_cvtepi32_pd(_mm_loadu_si128((const __m128i *)&weights[i]));
+        __m256d v = _mm256_cvtepi32_pd(_mm_loadu_si128((const __m128i *)&values[i]));
+        __m256d isZero = _mm256_cmp_pd(w, zero, _CMP_EQ_OQ);
+        __m256d r = _mm256_div_pd(v, _mm256_blendv_pd(w, one, isZero));
+        _mm256_store_pd(&ratio[i], _mm256_blendv_pd(r, inf, isZero));
+    }
+#endif
+    for (; i < n; i++) {
+        int isZero = (weights[i] == 0);
+        double r = (double)values[i] / (isZero ? 1.0 : (double)weights[i]);
+        ratio[i] = isZero ? HUGE_VAL : r;
+    }
+}
+
+// Function to solve the Knapsack problem using the Greedy approach.
+// Returns -1 if memory allocation fails.
 int knapsackGreedy(int W, int weights[], int values[], int n) {
-    // 1. Create an array of Item structs
-    Item items[n];
-    for (int i = 0; i < n; i++) {
-        items[i].weight = weights[i];
-        items[i].value = values[i];
-        items[i].ratio = (float)values[i] / weights[i];
+    // 1. Compute ratios into an aligned heap column (no stack VLA)
+    size_t bytes = ((size_t)n * sizeof(double) + SOA_ALIGNMENT - 1) / SOA_ALIGNMENT * SOA_ALIGNMENT;
+    double *ratio = (double *)aligned_alloc(SOA_ALIGNMENT, bytes);
+    RatioKey *keys = (RatioKey *)malloc((size_t)n * sizeof(RatioKey));
+    if (ratio == NULL || keys == NULL) {
+        free(ratio);
+        free(keys);
+        return -1;
     }
+    computeRatios(weights, values, ratio, n);
 
-    // 2. Sort items by value-to-weight ratio in descending order
-    qsort(items, n, sizeof(Item), compareItems);
+    // 2. Sort (ratio, index) keys by value-to-weight ratio in descending order
+    for (int i = 0; i < n; i++) {
+        keys[i].ratio = ratio[i];
+        keys[i].index = i;
+    }
+    qsort(keys, n, sizeof(RatioKey), compareRatioKeys);
 
-    int currentWeight = 0;
+    long long currentWeight = 0;
     int totalValue = 0;
 
     // 3. Iterate through sorted items and take them if they fit
-    for (int i = 0; i < n; i++) {
-        if (currentWeight + items[i].weight <= W) {
+    for (int r = 0; r < n; r++) {
+        int i = keys[r].index;
+        if (currentWeight + weights[i] <= W) {
             // Take the whole item
-            currentWeight += items[i].weight;
-            totalValue += items[i].value;
+            currentWeight += weights[i];
+            totalValue += values[i];
         }
     } 
+
+    free(ratio);
+    free(keys);
     return totalValue; 
 }
 
-int main() {
+/*
+ * Exact branch and bound. Items are sorted once by value/weight ratio;
+ * the bound of a node is its value plus the fractional knapsack of the
+ * remaining items (whole items while they fit, then a fraction of the
+ * next one), found by binary search over prefix sums. The search is
+ * depth first, taking an item before leaving it out, and drops every
+ * node whose bound cannot beat the best solution so far. The greedy fill
+ * in ratio order is the first incumbent. The take/leave decisions on the
+ * current path are kept per level, and copied out whenever a node beats
+ * the incumbent, so the best item set is known at the end.
+ */
+typedef struct {
+    long long nodeLimit; // Stop after this many nodes (0 = no limit)
+    double timeLimit;    // Stop after this many seconds of CPU time (0 = no limit)
+} BranchLimits;
+
+typedef struct {
+    int level;    // Next item to decide, in ratio order
+    int capacity; // Capacity left
+    int took;     // Whether item level - 1 was taken on the way here
+    long long value;
+} BranchNode;
+
+// Fractional knapsack bound for items [level, m) in ratio order, rounded down
+static long long fractionalBound(const long long prefixWeight[], const long long prefixValue[],
+                                 const int w[], const int p[], int m, int level, int capacity) {
+    // Last item that still fits whole: largest s with prefixWeight[s] - prefixWeight[level] <= capacity
+    int lo = level, hi = m;
+    long long limit = prefixWeight[level] + capacity;
+    while (lo < hi) {
+        int mid = lo + (hi - lo + 1) / 2;
+        if (prefixWeight[mid] <= limit) lo = mid;
+        else hi = mid - 1;
+    }
+    long long bound = prefixValue[lo] - prefixValue[level];
+    if (lo < m) {
+        bound += (long long)((double)(limit - prefixWeight[lo]) * p[lo] / w[lo]);
+    }
+    return bound;
+}
+
+// Returns the best value found, or -1 if memory allocation fails. *exact is
+// 1 if the search finished (the value is optimal), 0 if a limit stopped it.
+// taken[i] (room for n, may be NULL) is set to 1 for the items of that value.
+int knapsackBranchAndBound(int W, int weights[], int values[], int n, const BranchLimits *limits, int *exact,
+                           char taken[]) {
+    size_t bytes = ((size_t)n * sizeof(double) + SOA_ALIGNMENT - 1) / SOA_ALIGNMENT * SOA_ALIGNMENT;
+    double *ratio = (double *)aligned_alloc(SOA_ALIGNMENT, bytes > 0 ? bytes : SOA_ALIGNMENT);
+    RatioKey *keys = (RatioKey *)malloc(((size_t)n + 1) * sizeof(RatioKey));
+    int *w = (int *)malloc(((size_t)n + 1) * sizeof(int));
+    int *p = (int *)malloc(((size_t)n + 1) * sizeof(int));
+    long long *prefixWeight = (long long *)malloc(((size_t)n + 1) * sizeof(long long));
+    long long *prefixValue = (long long *)malloc(((size_t)n + 1) * sizeof(long long));
+    BranchNode *stack = (BranchNode *)malloc(((size_t)n + 2) * sizeof(BranchNode));
+    char *path = (char *)malloc((size_t)n + 1);     // path[k]: item k taken on the current path
+    char *bestPath = (char *)malloc((size_t)n + 1); // The same for the incumbent
+    *exact = 0;
+    if (ratio == NULL || keys == NULL || w == NULL || p == NULL ||
+        prefixWeight == NULL || prefixValue == NULL || stack == NULL || path == NULL || bestPath == NULL) {
+        free(ratio);
+        free(keys);
+        free(w);
+        free(p);
+        free(prefixWeight);
+        free(prefixValue);
+        free(stack);
+        free(path);
+        free(bestPath);
+        return -1;
+    }
+
+    // 1. Sort once by ratio, dropping items that can never fit or never help
+    computeRatios(weights, values, ratio, n);
+    int m = 0;
+    for (int i = 0; i < n; i++) {
+        if (weights[i] <= W && values[i] > 0) {
+            keys[m].ratio = ratio[i];
+            keys[m++].index = i;
+        }
+    }
+    qsort(keys, m, sizeof(RatioKey), compareRatioKeys);
+    prefixWeight[0] = prefixValue[0] = 0;
+    for (int k = 0; k < m; k++) {
+        w[k] = weights[keys[k].index];
+        p[k] = values[keys[k].index];
+        prefixWeight[k + 1] = prefixWeight[k] + w[k];
+        prefixValue[k + 1] = prefixValue[k] + p[k];
+    }
+
+    // 2. Greedy incumbent: take items in ratio order while they fit
+    long long room = W;
+    long long best = 0;
+    for (int k = 0; k < m; k++) {
+        bestPath[k] = (w[k] <= room);
+        if (bestPath[k]) {
+            room -= w[k];
+            best += p[k];
+        }
+    }
+
+    // 3. Depth-first search; the stack holds at most one pending sibling per level
+    clock_t start = clock();
+    long long nodes = 0;
+    int top = 0, stopped = 0;
+    stack[top].level = 0;
+    stack[top].capacity = W;
+    stack[top].took = 0;
+    stack[top++].value = 0;
+    while (top > 0) {
+        BranchNode node = stack[--top];
+        nodes++;
+        // Every node popped since this one's parent was deeper, so path[0 .. level - 2] still holds
+        if (node.level > 0) {
+            path[node.level - 1] = (char)node.took;
+        }
+        if (limits != NULL && ((limits->nodeLimit > 0 && nodes > limits->nodeLimit) ||
+            (limits->timeLimit > 0 && (nodes & 4095) == 0 &&
+             (double)(clock() - start) / CLOCKS_PER_SEC > limits->timeLimit))) {
+            stopped = 1; // 'best' is feasible but not proven optimal
+            break;
+        }
+        if (node.value > best) {
+            best = node.value;
+            memcpy(bestPath, path, (size_t)node.level);
+            memset(bestPath + node.level, 0, (size_t)(m - node.level));
+        }
+        if (node.level == m ||
+            node.value + fractionalBound(prefixWeight, prefixValue, w, p, m, node.level, node.capacity) <= best) {
+            continue;
+        }
+        // Push "leave out" first so "take" is explored first
+        int k = node.level;
+        stack[top].level = k + 1;
+        stack[top].capacity = node.capacity;
+        stack[top].took = 0;
+        stack[top++].value = node.value;
+        if (w[k] <= node.capacity) {
+            stack[top].level = k + 1;
+            stack[top].capacity = node.capacity - w[k];
+            stack[top].took = 1;
+            stack[top++].value = node.value + p[k];
+        }
+    }
+    *exact = !stopped;
+    if (taken != NULL) {
+        memset(taken, 0, (size_t)n);
+        for (int k = 0; k < m; k++) {
+            if (bestPath[k]) taken[keys[k].index] = 1;
+        }
+    }
+
+    free(ratio);
+    free(keys);
+    free(w);
+    free(p);
+    free(prefixWeight);
+    free(prefixValue);
+    free(stack);
+    free(path);
+    free(bestPath);
+    return (int)best;
+}
+
+typedef enum {
+    ENGINE_DENSE_DP,
+    ENGINE_PARETO,
+    ENGINE_BRANCH_AND_BOUND
+} KnapsackEngine;
+
+/*
+ * Upper bound on the Pareto solver's work, in frontier pairs summed over
+ * the items. After each item the frontier holds at most twice as many
+ * pairs as before, and weights and values both rise strictly along it,
+ * so it never has more than W + 1 pairs, nor more than the total value
+ * so far plus one.
+ */
+static double paretoWorkBound(int W, const int weights[], const int values[], int n) {
+    double work = 0.0, states = 1.0, valueSum = 0.0;
+    for (int i = 0; i < n; i++) {
+        if (weights[i] > W) continue; // The solver skips these
+        if (values[i] > 0) valueSum += values[i];
+        states = fmin(fmin(2.0 * states, (double)W + 1.0), valueSum + 1.0);
+        work += states;
+    }
+    return work;
+}
+
+/*
+ * Exact 0/1 value with the cheaper engine. The dense DP costs about n*W
+ * cells, so up to DENSE_DP_CHEAP_CELLS it runs directly. Beyond that,
+ * branch and bound and then the Pareto solver each get a trial worth
+ * 1/TRIAL_COST_SHARE of the DP's cost: a node budget for the first (at
+ * most BRANCH_NODE_LIMIT), and a frontier cap for the second, which is
+ * lifted when the work bound already proves it cheaper than the DP. Real
+ * frontiers are usually far below that bound. The DP runs when neither
+ * finishes, so a bad guess costs at most half the DP's time again. If
+ * the DP row cannot be allocated, the Pareto solver runs without a cap.
+ *
+ * The optimal item set goes to chosen[] (room for n) as item indices in
+ * increasing order, and their number to *chosenCount. Each engine
+ * recovers it its own way: branch and bound records it during the
+ * search, the DP repeats itself on two rows (knapsackDPItems), and the
+ * Pareto solver splits its frontiers (knapsackParetoItems), so tracing
+ * never costs more than the engine that won. *chosenCount is -1 if the
+ * trace runs out of memory. Returns -1 if memory allocation fails.
+ */
+int solveKnapsack01(int W, int weights[], int values[], int n, KnapsackEngine *engine,
+                    int chosen[], int *chosenCount) {
+    double cells = (double)n * W;
+    int best = -1;
+    *chosenCount = -1;
+
+    if (cells > DENSE_DP_CHEAP_CELLS) {
+        double budget = cells / (BRANCH_COST_RATIO * TRIAL_COST_SHARE);
+        BranchLimits limits = { budget < BRANCH_NODE_LIMIT ? (long long)budget : BRANCH_NODE_LIMIT, 0.0 };
+        char *taken = (char *)malloc((size_t)n);
+        int exact = 0;
+        best = (taken == NULL) ? -1 : knapsackBranchAndBound(W, weights, values, n, &limits, &exact, taken);
+        if (best >= 0 && exact) {
+            *engine = ENGINE_BRANCH_AND_BOUND;
+            *chosenCount = 0;
+            for (int i = 0; i < n; i++) {
+                if (taken[i]) chosen[(*chosenCount)++] = i;
+            }
+            free(taken);
+            return best;
+        }
+        free(taken);
+        best = -1;
+        int provenCheaper = (PARETO_COST_RATIO * paretoWorkBound(W, weights, values, n) < cells);
+        size_t frontierCap = (size_t)W / (PARETO_COST_RATIO * TRIAL_COST_SHARE);
+        if (provenCheaper || frontierCap > 0) {
+            best = knapsackPareto(W, weights, values, n, provenCheaper ? 0 : frontierCap);
+            *engine = ENGINE_PARETO;
+        }
+    }
+    if (best < 0) {
+        best = knapsackDP(W, weights, values, n);
+        *engine = ENGINE_DENSE_DP;
+    }
+    if (best < 0) {
+        best = knapsackPareto(W, weights, values, n, 0);
+        *engine = ENGINE_PARETO;
+    }
+    if (best >= 0) {
+        *chosenCount = (*engine == ENGINE_DENSE_DP) ? knapsackDPItems(W, weights, values, n, chosen)
+                                                    : knapsackParetoItems(W, weights, values, n, chosen);
+    }
+    return best;
+}
+
+/*
+ * Times the scalar and vector row updates for W = 10^5 .. 10^8 (sizes
+ * whose row cannot be allocated are skipped) and checks they agree.
+ * Smaller rows are updated more often, so every size does the same
+ * number of cell updates.
+ */
+void benchmarkRowKernels(void) {
+    printf("%-10s %-6s %12s %12s %8s\n", "W", "type", "scalar (s)", "vector (s)", "speedup");
+    srand(1);
+    for (long cap = 100000; cap <= 100000000; cap *= 10) {
+        int C = (int)cap;
+        int passes = (int)(100000000L / cap);
+        int weights[BENCHMARK_ITEMS], values[BENCHMARK_ITEMS];
+        for (int i = 0; i < BENCHMARK_ITEMS; i++) {
+            weights[i] = 1 + rand() % 1000;
+            values[i] = 1 + rand() % 1000;
+        }
+        for (int wide = 0; wide <= 1; wide++) {
+            size_t cell = wide ? sizeof(long long) : sizeof(int);
+            void *a = calloc((size_t)C + 1, cell);
+            void *b = calloc((size_t)C + 1, cell);
+            if (a == NULL || b == NULL) {
+                printf("%-10d %-6s skipped (out of memory)\n", C, wide ? "int64" : "int32");
+                free(a);
+                free(b);
+                continue;
+            }
+            memset(a, 0, ((size_t)C + 1) * cell); // Fault the pages in before timing
+            memset(b, 0, ((size_t)C + 1) * cell);
+            clock_t start = clock();
+            for (int i = 0; i < BENCHMARK_ITEMS * passes; i++) {
+                if (wide) rowUpdateScalar64((long long *)a, C, weights[i % BENCHMARK_ITEMS], values[i % BENCHMARK_ITEMS]);
+                else rowUpdateScalar32((int *)a, C, weights[i % BENCHMARK_ITEMS], values[i % BENCHMARK_ITEMS]);
+            }
+            clock_t middle = clock();
+            for (int i = 0; i < BENCHMARK_ITEMS * passes; i++) {
+                if (wide) rowUpdate64((long long *)b, C, weights[i % BENCHMARK_ITEMS], values[i % BENCHMARK_ITEMS]);
+                else rowUpdate32((int *)b, 0, C, weights[i % BENCHMARK_ITEMS], values[i % BENCHMARK_ITEMS]);
+            }
+            clock_t end = clock();
+            double scalar = (double)(middle - start) / CLOCKS_PER_SEC;
+            double vector = (double)(end - middle) / CLOCKS_PER_SEC;
+            printf("%-10d %-6s %12.3f %12.3f %7.1fx%s\n", C, wide ? "int64" : "int32", scalar, vector,
+                   vector > 0 ? scalar / vector : 0.0,
+                   memcmp(a, b, ((size_t)C + 1) * cell) == 0 ? "" : "  MISMATCH");
+            free(a);
+            free(b);
+        }
+    }
+}
+
+int main(int argc, char *argv[]) {
     int n, W;
 
+    // "-b": benchmark the DP row kernels instead of solving an instance
+    if (argc > 1 && strcmp(argv[1], "-b") == 0) {
+        benchmarkRowKernels();
+        return 0;
+    }
+
     // --- User Input ---
     printf("--- 0/1 Knapsack Problem Solver ---\n");
     printf("Enter the number of items (n): ");
@@ -117,23 +982,50 @@ int main() {
         scanf("%d", &values[i]);
     }
 
-    // --- Dynamic Programming Solution ---
+    // --- Exact Solution (the engine is picked by cost) ---
+    KnapsackEngine engine;
+    int chosenCount = -1;
+    int *chosen = (int *)malloc(n * sizeof(int));
+    int dp_result = (chosen == NULL) ? -1 : solveKnapsack01(W, weights, values, n, &engine, chosen, &chosenCount);
+    if (dp_result < 0) {
+        printf("Memory allocation failed.\n");
+        free(chosen);
+        free(weights);
+        free(values);
+        return 1;
+    }
     printf("\n==================================\n");
-    printf("Dynamic Programming Approach\n");
-    int dp_result = knapsackDP(W, weights, values, n);
+    printf("%s\n", engine == ENGINE_PARETO ? "Pareto Frontier Approach (Nemhauser-Ullmann)" :
+                  engine == ENGINE_BRANCH_AND_BOUND ? "Branch and Bound Approach" : "Dynamic Programming Approach");
     printf("Maximum Value (Optimal Solution): %d\n", dp_result);
+    if (chosenCount >= 0) {
+        printf("Items Chosen:");
+        for (int k = 0; k < chosenCount; k++) {
+            printf(" %d", chosen[k] + 1);
+        }
+        printf("\n");
+    } else {
+        printf("Items Chosen: not traced back (out of memory)\n");
+    }
+    free(chosen);
     printf("==================================\n");
 
     // --- Greedy Solution ---
     printf("\n==================================\n");
     printf("Greedy Approach (based on Value/Weight Ratio)\n");
     int greedy_result = knapsackGreedy(W, weights, values, n);
+    if (greedy_result < 0) {
+        printf("Memory allocation failed.\n");
+        free(weights);
+        free(values);
+        return 1;
+    }
     printf("Maximum Value (Greedy Solution): %d\n", greedy_result);
     printf("==================================\n");
 
     // --- Performance Analysis ---
     printf("\nPerformance Analysis:\n");
-    printf("The Dynamic Programming solution provides the GUARANTEED OPTIMAL result (%d).\n", dp_result);
+    printf("The exact solution provides the GUARANTEED OPTIMAL result (%d).\n", dp_result);
     printf("The Greedy solution is faster (O(n log n)) but may be sub-optimal (%d).\n", greedy_result);
     if (dp_result != greedy_result) {
         printf("In this instance, the Greedy approach DID NOT find the optimal solution.\n");